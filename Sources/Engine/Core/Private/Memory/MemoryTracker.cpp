@@ -0,0 +1,537 @@
+#include <Core/Memory/MemoryTracker.hpp>
+
+#if ZEN_MEMORY_TRACKING
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            constexpr size_t tagCount{ static_cast<size_t>(MemoryTag::Count) };
+            constexpr size_t maxThreadCount{ 256 };
+            constexpr int64_t peakFlushThreshold{ 64 * 1024 };
+
+            /**
+            * @brief スレッドごとの確保、解放の累計。書き込むのは所有するスレッドのみです。
+            *
+            * 最後の要素は、maxThreadCountを超えたスレッドが共有して使います。
+            */
+            struct alignas(64) ThreadCounters final
+            {
+                std::array<std::atomic<uint64_t>, tagCount> allocationCount;
+                std::array<std::atomic<uint64_t>, tagCount> allocatedBytes;
+                std::array<std::atomic<uint64_t>, tagCount> freeCount;
+                std::array<std::atomic<uint64_t>, tagCount> freedBytes;
+            };
+
+            /**
+            * @brief 確保したメモリの直前に置く情報。
+            */
+            struct AllocationHeader final
+            {
+                void* raw;      ///< mallocが返したアドレス
+                size_t size;    ///< 要求されたバイト数
+                MemoryTag tag;  ///< 確保時のタグ
+            };
+
+            std::array<ThreadCounters, maxThreadCount> threadCounters;
+            std::atomic<uint32_t> threadCounterCount{ 0 };
+
+            // 使用量はスレッドごとの増減をまとめてから反映する。最後の要素はすべてのタグの合計。
+            std::array<std::atomic<int64_t>, tagCount + 1> flushedLiveBytes;
+            std::array<std::atomic<int64_t>, tagCount + 1> peakLiveBytes;
+
+            thread_local ThreadCounters* currentCounters{ nullptr };
+            thread_local bool sharedCounters{ false };
+            thread_local MemoryTag currentTag{ MemoryTag::Unknown };
+            thread_local std::array<int64_t, tagCount + 1> pendingLiveBytes{};
+            thread_local bool threadExiting{ false };
+
+            std::array<std::atomic<const char*>, tagCount> registeredTagNames{};
+
+            void raisePeak(const size_t index, const int64_t live) noexcept
+            {
+                int64_t peak{ peakLiveBytes[index].load(std::memory_order_relaxed) };
+                while (live > peak && !peakLiveBytes[index].compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+                }
+            }
+
+            void flushPeak(const size_t index) noexcept
+            {
+                int64_t& pending{ pendingLiveBytes[index] };
+                const int64_t live{ flushedLiveBytes[index].fetch_add(pending, std::memory_order_relaxed) + pending };
+                pending = 0;
+                raisePeak(index, live);
+            }
+
+            /**
+            * @brief スレッドの終了時に、まとめている途中の増減を反映します。
+            *
+            * 破棄された後に行われる確保と解放は、まとめずにその場で反映します。
+            */
+            struct PendingFlusher final
+            {
+                ~PendingFlusher() noexcept
+                {
+                    threadExiting = true;
+                    for (size_t i = 0; i <= tagCount; ++i) {
+                        flushPeak(i);
+                    }
+                }
+            };
+
+            thread_local PendingFlusher pendingFlusher;
+
+            ThreadCounters& acquireCounters() noexcept
+            {
+                if (currentCounters == nullptr) {
+                    // 参照することで、このスレッドの終了時にデストラクタが呼ばれるようにする。
+                    static_cast<void>(&pendingFlusher);
+                    uint32_t index{ threadCounterCount.fetch_add(1, std::memory_order_acq_rel) };
+                    if (index >= maxThreadCount - 1) {
+                        index = maxThreadCount - 1;
+                        sharedCounters = true;
+                    }
+                    currentCounters = &threadCounters[index];
+                }
+                return *currentCounters;
+            }
+
+            void addCounter(std::atomic<uint64_t>& counter, const uint64_t value) noexcept
+            {
+                // 専有しているカウンターはロック付き命令を避け、読み出し側から値が見えるだけにする。
+                if (sharedCounters) {
+                    counter.fetch_add(value, std::memory_order_relaxed);
+                }
+                else {
+                    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+                }
+            }
+
+            void updatePeak(const size_t index, const int64_t delta) noexcept
+            {
+                int64_t& pending{ pendingLiveBytes[index] };
+                pending += delta;
+
+                // 最大値はまとめている途中でも反映し、しきい値に届かない増減で取りこぼさないようにする。
+                // 共有の値は読み出すだけなので、最大値を更新しない確保ではロック付き命令を使わない。
+                if (delta > 0) {
+                    const int64_t live{ flushedLiveBytes[index].load(std::memory_order_relaxed) + pending };
+                    if (live > peakLiveBytes[index].load(std::memory_order_relaxed)) {
+                        raisePeak(index, live);
+                    }
+                }
+
+                if (!threadExiting && pending < peakFlushThreshold && pending > -peakFlushThreshold) {
+                    return;
+                }
+                flushPeak(index);
+            }
+
+            void recordAllocation(const MemoryTag tag, const size_t size) noexcept
+            {
+                const size_t index{ static_cast<size_t>(tag) };
+                ThreadCounters& counters{ acquireCounters() };
+                addCounter(counters.allocationCount[index], 1);
+                addCounter(counters.allocatedBytes[index], size);
+                updatePeak(index, static_cast<int64_t>(size));
+                updatePeak(tagCount, static_cast<int64_t>(size));
+            }
+
+            void recordFree(const MemoryTag tag, const size_t size) noexcept
+            {
+                const size_t index{ static_cast<size_t>(tag) };
+                ThreadCounters& counters{ acquireCounters() };
+                addCounter(counters.freeCount[index], 1);
+                addCounter(counters.freedBytes[index], size);
+                updatePeak(index, -static_cast<int64_t>(size));
+                updatePeak(tagCount, -static_cast<int64_t>(size));
+            }
+
+            void* allocate(const size_t size, size_t alignment) noexcept
+            {
+                // 2のべき乗でないアライメントや、ヘッダーを加えると溢れるサイズは確保の失敗として扱う。
+                alignment = std::max(alignment, alignof(AllocationHeader));
+                constexpr size_t maxSize{ std::numeric_limits<size_t>::max() - sizeof(AllocationHeader) };
+                if ((alignment & (alignment - 1)) != 0 || alignment - 1 > maxSize || size > maxSize - (alignment - 1)) {
+                    return nullptr;
+                }
+
+                void* raw{ std::malloc(size + sizeof(AllocationHeader) + alignment - 1) };
+                if (raw == nullptr) {
+                    return nullptr;
+                }
+
+                const uintptr_t address{ (reinterpret_cast<uintptr_t>(raw) + sizeof(AllocationHeader) + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1) };
+                AllocationHeader* header{ reinterpret_cast<AllocationHeader*>(address) - 1 };
+                header->raw = raw;
+                header->size = size;
+                header->tag = currentTag;
+                recordAllocation(header->tag, size);
+                return reinterpret_cast<void*>(address);
+            }
+
+            void* allocateOrThrow(const size_t size, const size_t alignment)
+            {
+                for (;;) {
+                    void* pointer{ allocate(size, alignment) };
+                    if (pointer != nullptr) {
+                        return pointer;
+                    }
+                    const std::new_handler handler{ std::get_new_handler() };
+                    if (handler == nullptr) {
+                        throw std::bad_alloc{};
+                    }
+                    handler();
+                }
+            }
+
+            void* allocateNoThrow(const size_t size, const size_t alignment) noexcept
+            {
+                try {
+                    return allocateOrThrow(size, alignment);
+                }
+                catch (...) {
+                    return nullptr;
+                }
+            }
+
+            void deallocate(void* pointer) noexcept
+            {
+                if (pointer == nullptr) {
+                    return;
+                }
+                const AllocationHeader* header{ static_cast<const AllocationHeader*>(pointer) - 1 };
+                recordFree(header->tag, header->size);
+                std::free(header->raw);
+            }
+
+            /**
+            * @brief 定期的な書き出しの状態。
+            */
+            struct CaptureState final
+            {
+                std::mutex mutex;
+                std::condition_variable condition;
+                std::thread thread;
+                std::FILE* file{ nullptr };
+                bool stopRequested{ false };
+            };
+
+            CaptureState& getCaptureState()
+            {
+                static CaptureState state;
+                return state;
+            }
+
+            /**
+            * @brief 名前が登録されておらず、一度も使われていないUser以降のタグを出力から除外するために使います。
+            */
+            bool isTagInUse(const MemoryTag tag, const memory::TagStats& stats) noexcept
+            {
+                if (tag < MemoryTag::User || tag == MemoryTag::Count) {
+                    return true;
+                }
+                return stats.allocationCount != 0 || registeredTagNames[static_cast<size_t>(tag)].load(std::memory_order_acquire) != nullptr;
+            }
+
+            void writeSnapshot(std::FILE* file, const double timeSeconds, const double elapsedSeconds, std::array<memory::TagStats, tagCount + 1>& previous)
+            {
+                for (size_t i = 0; i <= tagCount; ++i) {
+                    const MemoryTag tag{ static_cast<MemoryTag>(i) };
+                    const memory::TagStats stats{ memory::getTagStats(tag) };
+                    if (!isTagInUse(tag, stats)) {
+                        continue;
+                    }
+                    const double bytesPerSecond{ (elapsedSeconds > 0.0) ? static_cast<double>(stats.allocatedBytes - previous[i].allocatedBytes) / elapsedSeconds : 0.0 };
+                    const double allocationsPerSecond{ (elapsedSeconds > 0.0) ? static_cast<double>(stats.allocationCount - previous[i].allocationCount) / elapsedSeconds : 0.0 };
+                    std::fprintf(file, "%.3f,%s,%llu,%llu,%llu,%.1f,%.1f\n",
+                        timeSeconds,
+                        memory::getTagName(tag),
+                        static_cast<unsigned long long>(stats.liveBytes),
+                        static_cast<unsigned long long>(stats.liveCount),
+                        static_cast<unsigned long long>(stats.peakBytes),
+                        bytesPerSecond,
+                        allocationsPerSecond);
+                    previous[i] = stats;
+                }
+                std::fflush(file);
+            }
+
+            void runCapture(std::FILE* file, const std::chrono::milliseconds interval)
+            {
+                using Clock = std::chrono::steady_clock;
+
+                CaptureState& state{ getCaptureState() };
+                std::array<memory::TagStats, tagCount + 1> previous{};
+                for (size_t i = 0; i <= tagCount; ++i) {
+                    previous[i] = memory::getTagStats(static_cast<MemoryTag>(i));
+                }
+
+                std::fprintf(file, "time,tag,live_bytes,live_count,peak_bytes,allocated_bytes_per_second,allocations_per_second\n");
+                const Clock::time_point start{ Clock::now() };
+                Clock::time_point last{ start };
+                bool stop{ false };
+                while (!stop) {
+                    {
+                        std::unique_lock<std::mutex> lock{ state.mutex };
+                        stop = state.condition.wait_for(lock, interval, [&state] { return state.stopRequested; });
+                    }
+                    const Clock::time_point now{ Clock::now() };
+                    writeSnapshot(file,
+                        std::chrono::duration<double>(now - start).count(),
+                        std::chrono::duration<double>(now - last).count(),
+                        previous);
+                    last = now;
+                }
+            }
+        }
+    }
+
+    namespace memory
+    {
+        TagScope::TagScope(const MemoryTag tag) noexcept
+            : _previous{ internal::currentTag }
+        {
+            internal::currentTag = tag;
+        }
+
+        TagScope::~TagScope() noexcept
+        {
+            internal::currentTag = _previous;
+        }
+
+        MemoryTag getCurrentTag() noexcept
+        {
+            return internal::currentTag;
+        }
+
+        void registerTagName(const MemoryTag tag, const char* name) noexcept
+        {
+            ZEN_EXPECTS_MSG(tag >= MemoryTag::User && tag < MemoryTag::Count, u"MemoryTagOutOfRange");
+            internal::registeredTagNames[static_cast<size_t>(tag)].store(name, std::memory_order_release);
+        }
+
+        const char* getTagName(const MemoryTag tag) noexcept
+        {
+            switch (tag) {
+            case MemoryTag::Unknown:
+                return "Unknown";
+            case MemoryTag::Core:
+                return "Core";
+            case MemoryTag::Math:
+                return "Math";
+            case MemoryTag::Count:
+                return "Total";
+            default:
+                break;
+            }
+
+            if (tag >= MemoryTag::User && tag < MemoryTag::Count) {
+                const char* name{ internal::registeredTagNames[static_cast<size_t>(tag)].load(std::memory_order_acquire) };
+                return (name != nullptr) ? name : "Unregistered";
+            }
+            return "Invalid";
+        }
+
+        TagStats getTagStats(const MemoryTag tag) noexcept
+        {
+            const size_t index{ static_cast<size_t>(tag) };
+            const size_t firstTag{ (tag == MemoryTag::Count) ? 0 : index };
+            const size_t lastTag{ (tag == MemoryTag::Count) ? internal::tagCount : index + 1 };
+            const size_t threadCount{ std::min<size_t>(internal::threadCounterCount.load(std::memory_order_acquire), internal::maxThreadCount) };
+
+            uint64_t allocationCount{ 0 };
+            uint64_t allocatedBytes{ 0 };
+            uint64_t freeCount{ 0 };
+            uint64_t freedBytes{ 0 };
+            for (size_t thread = 0; thread < threadCount; ++thread) {
+                const internal::ThreadCounters& counters{ internal::threadCounters[thread] };
+                for (size_t i = firstTag; i < lastTag; ++i) {
+                    allocationCount += counters.allocationCount[i].load(std::memory_order_relaxed);
+                    allocatedBytes += counters.allocatedBytes[i].load(std::memory_order_relaxed);
+                    freeCount += counters.freeCount[i].load(std::memory_order_relaxed);
+                    freedBytes += counters.freedBytes[i].load(std::memory_order_relaxed);
+                }
+            }
+
+            // 別スレッドの解放を先に読むと一時的に負になるため、0で打ち止める。
+            TagStats stats{};
+            stats.allocationCount = allocationCount;
+            stats.allocatedBytes = allocatedBytes;
+            stats.liveCount = (allocationCount > freeCount) ? allocationCount - freeCount : 0;
+            stats.liveBytes = (allocatedBytes > freedBytes) ? allocatedBytes - freedBytes : 0;
+            stats.peakBytes = std::max<uint64_t>(stats.liveBytes, static_cast<uint64_t>(std::max<int64_t>(internal::peakLiveBytes[index].load(std::memory_order_relaxed), 0)));
+            return stats;
+        }
+
+        bool beginCapture(const char* path, const std::chrono::milliseconds interval)
+        {
+            internal::CaptureState& state{ internal::getCaptureState() };
+            std::lock_guard<std::mutex> lock{ state.mutex };
+            if (state.file != nullptr) {
+                return false;
+            }
+
+            state.file = std::fopen(path, "w");
+            if (state.file == nullptr) {
+                return false;
+            }
+            state.stopRequested = false;
+            state.thread = std::thread{ [file = state.file, interval] {
+                const TagScope scope{ MemoryTag::Core };
+                internal::runCapture(file, interval);
+            } };
+            return true;
+        }
+
+        void endCapture()
+        {
+            internal::CaptureState& state{ internal::getCaptureState() };
+            {
+                std::lock_guard<std::mutex> lock{ state.mutex };
+                if (state.file == nullptr) {
+                    return;
+                }
+                state.stopRequested = true;
+            }
+            state.condition.notify_all();
+            state.thread.join();
+
+            std::lock_guard<std::mutex> lock{ state.mutex };
+            std::fclose(state.file);
+            state.file = nullptr;
+        }
+
+        uint32_t reportLeaks(std::FILE* output)
+        {
+            uint32_t leakedTagCount{ 0 };
+            for (size_t i = 0; i < internal::tagCount; ++i) {
+                const MemoryTag tag{ static_cast<MemoryTag>(i) };
+                const TagStats stats{ getTagStats(tag) };
+                if (stats.liveCount == 0) {
+                    continue;
+                }
+                std::fprintf(output, "memory leak: %-12s %llu bytes in %llu allocations (peak %llu bytes)\n",
+                    getTagName(tag),
+                    static_cast<unsigned long long>(stats.liveBytes),
+                    static_cast<unsigned long long>(stats.liveCount),
+                    static_cast<unsigned long long>(stats.peakBytes));
+                ++leakedTagCount;
+            }
+            return leakedTagCount;
+        }
+    }
+}
+
+void* operator new(const std::size_t size)
+{
+    return zen::internal::allocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](const std::size_t size)
+{
+    return zen::internal::allocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return zen::internal::allocateNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return zen::internal::allocateNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    return zen::internal::allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return zen::internal::allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return zen::internal::allocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return zen::internal::allocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    zen::internal::deallocate(pointer);
+}
+#endif
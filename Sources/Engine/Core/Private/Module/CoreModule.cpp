@@ -0,0 +1,10 @@
+#include <Core/Module/CoreModule.hpp>
+
+namespace zen
+{
+    ModuleDescriptor makeCoreModule()
+    {
+        // 現時点ではCoreに初期化が必要な状態はないため、フックは登録しない。
+        return ModuleDescriptor{ "Core", {}, nullptr, nullptr, MemoryTag::Core };
+    }
+}
@@ -0,0 +1,230 @@
+#include <Core/Module/ModuleRegistry.hpp>
+#include <Core/Misc/Assert.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace zen
+{
+    ModuleRegistry::~ModuleRegistry()
+    {
+        shutdown();
+    }
+
+    void ModuleRegistry::add(ModuleDescriptor descriptor)
+    {
+        ZEN_EXPECTS_MSG(_initializedOrder.empty(), u"ModuleRegistryAlreadyStarted");
+        _modules.push_back(std::move(descriptor));
+    }
+
+    bool ModuleRegistry::startup(const uint32_t workerCount)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        ZEN_EXPECTS_MSG(_initializedOrder.empty(), u"ModuleRegistryAlreadyStarted");
+        _startupTimings.clear();
+        _startupDuration = std::chrono::nanoseconds{ 0 };
+        _error.clear();
+
+        const Clock::time_point startupBegin{ Clock::now() };
+
+        std::vector<std::vector<size_t>> dependents;
+        std::vector<size_t> dependencyCounts;
+        if (!resolveDependencies(dependents, dependencyCounts)) {
+            return false;
+        }
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<size_t> readyModules;
+        std::vector<std::thread> workers;
+        const uint32_t maxWorkerCount{ std::max<uint32_t>(workerCount, 1) };
+        uint32_t idleCount{ 1 };     // 呼び出し元のスレッドもワーカーの一つとして使う
+        size_t runningCount{ 0 };
+        bool failed{ false };
+
+        for (size_t i = 0; i < _modules.size(); ++i) {
+            if (dependencyCounts[i] == 0) {
+                readyModules.push_back(i);
+            }
+        }
+
+        // 依存先の初期化が終わったモジュールから順に、空いているワーカーが取り出して初期化する。
+        // ワーカーは待機中のモジュールに対して手が足りない場合にだけ追加し、依存関係が直列な場合はスレッドを作らない。
+        std::function<void(uint32_t)> work;
+        const auto spawnWorkers = [&] {
+            while (!failed && readyModules.size() > idleCount && workers.size() + 1 < maxWorkerCount) {
+                workers.emplace_back(work, static_cast<uint32_t>(workers.size() + 1));
+                ++idleCount;
+            }
+        };
+
+        work = [&](const uint32_t workerIndex) {
+            std::unique_lock<std::mutex> lock{ mutex };
+            for (;;) {
+                condition.wait(lock, [&] { return failed || !readyModules.empty() || runningCount == 0; });
+                if (failed || readyModules.empty()) {
+                    return;
+                }
+
+                const size_t index{ readyModules.front() };
+                readyModules.pop_front();
+                ++runningCount;
+                --idleCount;
+                lock.unlock();
+
+                const ModuleDescriptor& module{ _modules[index] };
+                const Clock::time_point begin{ Clock::now() };
+                bool succeeded{ true };
+                std::string failure;
+                if (module.initialize) {
+                    ZEN_MEMORY_SCOPE(module.memoryTag);
+                    // ワーカー上で例外が抜けるとstd::terminateになるため、初期化の失敗として扱う。
+                    try {
+                        succeeded = module.initialize();
+                    }
+                    catch (const std::exception& exception) {
+                        succeeded = false;
+                        failure = exception.what();
+                    }
+                    catch (...) {
+                        succeeded = false;
+                        failure = "unknown exception";
+                    }
+                }
+                const Clock::time_point end{ Clock::now() };
+
+                lock.lock();
+                --runningCount;
+                ++idleCount;
+                _startupTimings.push_back(ModuleTiming{ module.name, begin - startupBegin, end - begin, workerIndex });
+                if (succeeded) {
+                    _initializedOrder.push_back(index);
+                    for (const size_t dependent : dependents[index]) {
+                        if (--dependencyCounts[dependent] == 0) {
+                            readyModules.push_back(dependent);
+                        }
+                    }
+                    spawnWorkers();
+                }
+                else if (!failed) {
+                    failed = true;
+                    _error = "Failed to initialize module '" + module.name + "'";
+                    if (!failure.empty()) {
+                        _error += ": " + failure;
+                    }
+                }
+                condition.notify_all();
+            }
+        };
+
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            spawnWorkers();
+        }
+        work(0);
+
+        // 呼び出し元が抜けた時点で待機中のモジュールはなく、以降ワーカーが追加されることはない。
+        std::vector<std::thread> spawnedWorkers;
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            spawnedWorkers.swap(workers);
+        }
+        for (std::thread& worker : spawnedWorkers) {
+            worker.join();
+        }
+
+        std::sort(_startupTimings.begin(), _startupTimings.end(), [](const ModuleTiming& a, const ModuleTiming& b) { return a.start < b.start; });
+        _startupDuration = Clock::now() - startupBegin;
+
+        if (failed) {
+            shutdown();
+            return false;
+        }
+        ZEN_ENSURES(_initializedOrder.size() == _modules.size());
+        return true;
+    }
+
+    void ModuleRegistry::shutdown()
+    {
+        for (std::vector<size_t>::const_reverse_iterator it = _initializedOrder.crbegin(); it != _initializedOrder.crend(); ++it) {
+            const ModuleDescriptor& module{ _modules[*it] };
+            if (module.shutdown) {
+                ZEN_MEMORY_SCOPE(module.memoryTag);
+                module.shutdown();
+            }
+        }
+        _initializedOrder.clear();
+    }
+
+    const std::vector<ModuleTiming>& ModuleRegistry::getStartupTimings() const noexcept
+    {
+        return _startupTimings;
+    }
+
+    std::chrono::nanoseconds ModuleRegistry::getStartupDuration() const noexcept
+    {
+        return _startupDuration;
+    }
+
+    const std::string& ModuleRegistry::getError() const noexcept
+    {
+        return _error;
+    }
+
+    bool ModuleRegistry::resolveDependencies(std::vector<std::vector<size_t>>& dependents, std::vector<size_t>& dependencyCounts)
+    {
+        std::unordered_map<std::string, size_t> indices;
+        for (size_t i = 0; i < _modules.size(); ++i) {
+            if (!indices.emplace(_modules[i].name, i).second) {
+                _error = "Module '" + _modules[i].name + "' is registered twice";
+                return false;
+            }
+        }
+
+        dependents.assign(_modules.size(), {});
+        dependencyCounts.assign(_modules.size(), 0);
+        for (size_t i = 0; i < _modules.size(); ++i) {
+            for (const std::string& dependency : _modules[i].dependencies) {
+                const std::unordered_map<std::string, size_t>::const_iterator found{ indices.find(dependency) };
+                if (found == indices.end()) {
+                    _error = "Module '" + _modules[i].name + "' depends on unknown module '" + dependency + "'";
+                    return false;
+                }
+                dependents[found->second].push_back(i);
+                ++dependencyCounts[i];
+            }
+        }
+
+        // 並列に初期化を始める前に、トポロジカルソートで循環依存がないことを確認しておく。
+        std::vector<size_t> remaining{ dependencyCounts };
+        std::vector<size_t> stack;
+        for (size_t i = 0; i < _modules.size(); ++i) {
+            if (remaining[i] == 0) {
+                stack.push_back(i);
+            }
+        }
+        size_t visitedCount{ 0 };
+        while (!stack.empty()) {
+            const size_t index{ stack.back() };
+            stack.pop_back();
+            ++visitedCount;
+            for (const size_t dependent : dependents[index]) {
+                if (--remaining[dependent] == 0) {
+                    stack.push_back(dependent);
+                }
+            }
+        }
+        if (visitedCount != _modules.size()) {
+            _error = "Module dependencies contain a cycle";
+            return false;
+        }
+        return true;
+    }
+}
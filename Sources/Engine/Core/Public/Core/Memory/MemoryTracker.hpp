@@ -0,0 +1,136 @@
+#pragma once
+#include <Core/Misc/Assert.hpp>
+#include <cstdint>
+
+namespace zen
+{
+    /**
+    * @brief メモリの所有者を表すタグ。ZEN_MEMORY_SCOPEで現在のスレッドに設定します。
+    *
+    * Coreより上位のレイヤーは、User以降の範囲からmakeUserMemoryTag()でタグを作成し、
+    * ZEN_MEMORY_REGISTER_TAGで名前を登録して使います。
+    */
+    enum class MemoryTag : uint8_t
+    {
+        Unknown,
+        Core,
+        Math,
+
+        User,       ///< 上位のレイヤー用に予約された範囲の先頭
+
+        Count = 16,
+    };
+
+    /**
+    * @brief 上位のレイヤー用のメモリタグを作成します。
+    *
+    * @param[in] offset MemoryTag::Userからのオフセット
+    */
+    [[nodiscard]] constexpr MemoryTag makeUserMemoryTag(const uint8_t offset) noexcept
+    {
+        ZEN_EXPECTS_MSG(offset < static_cast<uint8_t>(MemoryTag::Count) - static_cast<uint8_t>(MemoryTag::User), u"MemoryTagOutOfRange");
+        return static_cast<MemoryTag>(static_cast<uint8_t>(MemoryTag::User) + offset);
+    }
+}
+
+#if ZEN_MEMORY_TRACKING
+#include <chrono>
+#include <cstdio>
+
+namespace zen
+{
+    namespace memory
+    {
+        /**
+        * @brief タグごとのメモリ使用量。
+        */
+        struct TagStats final
+        {
+            uint64_t liveBytes{ 0 };            ///< 解放されていないバイト数
+            uint64_t liveCount{ 0 };            ///< 解放されていない確保の数
+            uint64_t peakBytes{ 0 };            ///< liveBytesの最大値
+            uint64_t allocatedBytes{ 0 };       ///< これまでに確保された総バイト数
+            uint64_t allocationCount{ 0 };      ///< これまでの確保の回数
+        };
+
+        /**
+        * @brief スコープの間、現在のスレッドのメモリタグを切り替えます。
+        */
+        class TagScope final
+        {
+        public:
+            explicit TagScope(MemoryTag tag) noexcept;
+            ~TagScope() noexcept;
+
+            TagScope(const TagScope&) = delete;
+            TagScope& operator=(const TagScope&) = delete;
+
+        private:
+            MemoryTag _previous;    ///< スコープに入る前のタグ
+        };
+
+        /**
+        * @brief 現在のスレッドのメモリタグを取得します。
+        */
+        [[nodiscard]] MemoryTag getCurrentTag() noexcept;
+
+        /**
+        * @brief User以降のタグに名前を登録します。
+        *
+        * @param[in] name タグの名前。プログラムの終了まで有効な文字列を指定してください。
+        */
+        void registerTagName(MemoryTag tag, const char* name) noexcept;
+
+        /**
+        * @brief タグの名前を取得します。名前が登録されていないタグは"Unregistered"を返します。
+        */
+        [[nodiscard]] const char* getTagName(MemoryTag tag) noexcept;
+
+        /**
+        * @brief タグのメモリ使用量を集計します。
+        *
+        * 確保数と確保量は正確な値です。peakBytesは確保したスレッドから見た最大値で、
+        * 他のスレッドが同時に確保している分のうち、まだ反映されていない64KiB未満の増減は含みません。
+        *
+        * @param[in] tag 集計するタグ。MemoryTag::Countを指定するとすべてのタグの合計を返します。
+        */
+        [[nodiscard]] TagStats getTagStats(MemoryTag tag) noexcept;
+
+        /**
+        * @brief 一定間隔でタグごとの使用量と確保レートをCSVとしてファイルに書き出します。
+        *
+        * @return ファイルを開けなかった場合、またはすでに書き出し中の場合はfalse
+        */
+        bool beginCapture(const char* path, std::chrono::milliseconds interval);
+
+        /**
+        * @brief beginCapture()で開始した書き出しを終了します。
+        */
+        void endCapture();
+
+        /**
+        * @brief 解放されていないメモリをタグごとに出力します。
+        *
+        * 静的変数や標準ライブラリが保持するメモリも含まれるため、Unknownタグの値は参考値です。
+        *
+        * @return 解放されていないメモリがあるタグの数
+        */
+        uint32_t reportLeaks(std::FILE* output);
+    }
+}
+
+#define ZEN_MEMORY_CONCAT_INNER(a, b) a##b
+#define ZEN_MEMORY_CONCAT(a, b) ZEN_MEMORY_CONCAT_INNER(a, b)
+#define ZEN_MEMORY_SCOPE(tag) const ::zen::memory::TagScope ZEN_MEMORY_CONCAT(zenMemoryScope, __LINE__){ tag }
+#define ZEN_MEMORY_REGISTER_TAG(tag, name) ::zen::memory::registerTagName(tag, name)
+#define ZEN_MEMORY_BEGIN_CAPTURE(path, interval) ::zen::memory::beginCapture(path, interval)
+#define ZEN_MEMORY_END_CAPTURE() ::zen::memory::endCapture()
+#define ZEN_MEMORY_REPORT_LEAKS(output) ::zen::memory::reportLeaks(output)
+
+#else
+#define ZEN_MEMORY_SCOPE(tag) ((void)0)
+#define ZEN_MEMORY_REGISTER_TAG(tag, name) ((void)0)
+#define ZEN_MEMORY_BEGIN_CAPTURE(path, interval) ((void)0)
+#define ZEN_MEMORY_END_CAPTURE() ((void)0)
+#define ZEN_MEMORY_REPORT_LEAKS(output) ((void)0)
+#endif
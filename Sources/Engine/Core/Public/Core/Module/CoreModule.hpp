@@ -0,0 +1,11 @@
+#pragma once
+#include <Core/Module/ModuleRegistry.hpp>
+
+namespace zen
+{
+    /**
+    * @brief Coreモジュールの宣言を作成します。
+    */
+    [[nodiscard]]
+    ModuleDescriptor makeCoreModule();
+}
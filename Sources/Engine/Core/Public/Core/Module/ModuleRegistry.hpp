@@ -0,0 +1,103 @@
+#pragma once
+#include <Core/Memory/MemoryTracker.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace zen
+{
+    /**
+    * @brief エンジンモジュールの宣言。
+    *
+    * 依存するモジュールの初期化が終わってから initialize が呼び出され、
+    * 依存されているモジュールより先に shutdown が呼び出されます。
+    */
+    struct ModuleDescriptor final
+    {
+        std::string name;                       ///< モジュール名
+        std::vector<std::string> dependencies;  ///< 依存するモジュール名
+        std::function<bool()> initialize;       ///< 初期化処理。失敗した場合はfalseを返します。
+        std::function<void()> shutdown;         ///< 終了処理
+        MemoryTag memoryTag{ MemoryTag::Unknown };  ///< 初期化、終了処理中に確保したメモリのタグ
+    };
+
+    /**
+    * @brief モジュールひとつ分の初期化の計測結果。
+    */
+    struct ModuleTiming final
+    {
+        std::string name;                   ///< モジュール名
+        std::chrono::nanoseconds start;     ///< 起動処理の開始から初期化を開始するまでの時間
+        std::chrono::nanoseconds duration;  ///< 初期化にかかった時間
+        uint32_t workerIndex;               ///< 初期化を実行したワーカーの番号
+    };
+
+    /**
+    * @brief モジュールを依存関係の順に初期化、終了します。
+    *
+    * 互いに依存しないモジュールはワーカースレッド上で並列に初期化されます。
+    * 終了処理は初期化が完了した順の逆順で、呼び出し元のスレッドで行われます。
+    */
+    class ModuleRegistry final
+    {
+    public:
+        ModuleRegistry() = default;
+        ~ModuleRegistry();
+
+        ModuleRegistry(const ModuleRegistry&) = delete;
+        ModuleRegistry& operator=(const ModuleRegistry&) = delete;
+
+        /**
+        * @brief モジュールを登録します。
+        *
+        * @pre startup()の呼び出し前でなければいけません。
+        */
+        void add(ModuleDescriptor descriptor);
+
+        /**
+        * @brief 登録されたすべてのモジュールを初期化します。
+        *
+        * 依存先が見つからない場合や循環依存がある場合は、何も初期化せずに失敗します。
+        * 初期化に失敗したモジュールがあった場合は、初期化済みのモジュールを終了してから失敗します。
+        * initializeが例外を送出した場合も初期化の失敗として扱います。
+        * ワーカースレッドは同時に初期化できるモジュールがある場合にだけ追加します。
+        *
+        * @param[in] workerCount 初期化に使うワーカースレッドの最大数
+        *
+        * @return すべてのモジュールの初期化に成功した場合はtrue
+        */
+        [[nodiscard]] bool startup(uint32_t workerCount);
+
+        /**
+        * @brief 初期化済みのモジュールを依存関係の逆順に終了します。
+        */
+        void shutdown();
+
+        /**
+        * @brief 直前のstartup()で初期化を実行したモジュールの計測結果を、初期化を開始した順に取得します。
+        */
+        [[nodiscard]] const std::vector<ModuleTiming>& getStartupTimings() const noexcept;
+
+        /**
+        * @brief 直前のstartup()全体にかかった時間を取得します。
+        */
+        [[nodiscard]] std::chrono::nanoseconds getStartupDuration() const noexcept;
+
+        /**
+        * @brief 直前のstartup()が失敗した理由を取得します。成功した場合は空文字列です。
+        */
+        [[nodiscard]] const std::string& getError() const noexcept;
+
+    private:
+        [[nodiscard]] bool resolveDependencies(std::vector<std::vector<size_t>>& dependents, std::vector<size_t>& dependencyCounts);
+
+        std::vector<ModuleDescriptor> _modules;     ///< 登録されたモジュール
+        std::vector<size_t> _initializedOrder;      ///< 初期化が完了した順のモジュールのインデックス
+        std::vector<ModuleTiming> _startupTimings;  ///< 初期化の計測結果
+        std::chrono::nanoseconds _startupDuration{ 0 };
+        std::string _error;
+    };
+}
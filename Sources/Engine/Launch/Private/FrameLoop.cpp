@@ -0,0 +1,260 @@
+#include "FrameLoop.hpp"
+#include "LaunchMemoryTag.hpp"
+#include <Core/Misc/Assert.hpp>
+#include <Math/Random.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <utility>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            constexpr size_t statsCapacity{ 1 << 16 };
+            constexpr size_t bodyCount{ 4096 };
+            constexpr std::chrono::milliseconds maxFrameDelta{ 250 };
+            constexpr float gravity{ -9.8f };
+            constexpr float restitution{ 0.8f };
+            constexpr uint64_t bodySeed{ 0x5a454e };
+            constexpr float spawnRadius{ 32.0f };
+            constexpr float spawnHeight{ 40.0f };
+            constexpr float spawnSpeed{ 5.0f };
+
+            void initializeBodies(SimulationState& state)
+            {
+                // 同じシードから生成するため、previousとcurrentは同じ初期状態になる。
+                Random random{ bodySeed };
+                const Vector3f center{ 0.0f, spawnHeight, 0.0f };
+                state.positions.resize(bodyCount);
+                state.velocities.resize(bodyCount);
+                for (size_t i = 0; i < bodyCount; ++i) {
+                    state.positions[i] = center + random.nextPointInSphere(spawnRadius);
+                    state.velocities[i] = random.nextUnitVector() * spawnSpeed;
+                }
+            }
+
+            void printSummary(const char* label, const FrameStatsSummary& summary)
+            {
+                std::printf("%-12s %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f\n",
+                    label, summary.min, summary.mean, summary.p50, summary.p90, summary.p99, summary.max, summary.jitter);
+            }
+        }
+    }
+
+    OutputStage::OutputStage()
+        : _stats{ internal::statsCapacity }
+    {
+        _thread = std::thread{ [this] { run(); } };
+    }
+
+    OutputStage::~OutputStage()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            _exit = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+
+    FrameState& OutputStage::acquire(const uint64_t frameIndex)
+    {
+        std::unique_lock<std::mutex> lock{ _mutex };
+        ZEN_EXPECTS(frameIndex == _submittedCount);
+        _condition.wait(lock, [this, frameIndex] { return frameIndex < _completedCount + _frames.size(); });
+        return _frames[frameIndex % _frames.size()];
+    }
+
+    void OutputStage::submit(const uint64_t frameIndex)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            ZEN_EXPECTS(frameIndex == _submittedCount);
+            _submittedCount = frameIndex + 1;
+        }
+        _condition.notify_all();
+    }
+
+    void OutputStage::flush()
+    {
+        std::unique_lock<std::mutex> lock{ _mutex };
+        _condition.wait(lock, [this] { return _completedCount == _submittedCount; });
+    }
+
+    const FrameStats& OutputStage::getStats() const noexcept
+    {
+        return _stats;
+    }
+
+    double OutputStage::getChecksum() const noexcept
+    {
+        return _checksum;
+    }
+
+    void OutputStage::run()
+    {
+        ZEN_MEMORY_SCOPE(outputMemoryTag);
+        for (;;) {
+            uint64_t frameIndex{ 0 };
+            {
+                std::unique_lock<std::mutex> lock{ _mutex };
+                // 終了要求があっても、渡されたフレームはすべて出力してから抜ける。
+                _condition.wait(lock, [this] { return _exit || _completedCount < _submittedCount; });
+                if (_completedCount == _submittedCount) {
+                    return;
+                }
+                frameIndex = _completedCount;
+            }
+
+            const std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+            process(_frames[frameIndex % _frames.size()]);
+            _stats.record(std::chrono::steady_clock::now() - start);
+
+            {
+                std::lock_guard<std::mutex> lock{ _mutex };
+                ++_completedCount;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    void OutputStage::process(const FrameState& frame)
+    {
+        const size_t count{ frame.currentPositions.size() };
+        _interpolated.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            _interpolated[i] = Vector3f::lerp(frame.previousPositions[i], frame.currentPositions[i], frame.alpha);
+        }
+
+        // 描画先がまだ存在しないため、ポストプロセスとして境界ボックスを求めて結果を残す。
+        Vector3f boundsMin{ std::numeric_limits<float>::max() };
+        Vector3f boundsMax{ std::numeric_limits<float>::lowest() };
+        for (const Vector3f& position : _interpolated) {
+            boundsMin = Vector3f{ std::min(boundsMin.getX(), position.getX()), std::min(boundsMin.getY(), position.getY()), std::min(boundsMin.getZ(), position.getZ()) };
+            boundsMax = Vector3f{ std::max(boundsMax.getX(), position.getX()), std::max(boundsMax.getY(), position.getY()), std::max(boundsMax.getZ(), position.getZ()) };
+        }
+        const Vector3f extent{ boundsMax - boundsMin };
+        _checksum = static_cast<double>(extent.getX() + extent.getY() + extent.getZ());
+    }
+
+    FrameLoop::FrameLoop(const LaunchOptions& options)
+        : _options{ options }
+        , _tickDuration{ std::chrono::duration_cast<Clock::duration>(std::chrono::seconds{ 1 }) / std::clamp<uint32_t>(options.tickRate, 1, maxTickRate) }
+        , _frameDuration{ (options.frameRate == 0) ? Clock::duration::zero() : std::chrono::duration_cast<Clock::duration>(std::chrono::seconds{ 1 }) / std::min(options.frameRate, maxFrameRate) }
+        , _frameStats{ internal::statsCapacity }
+        , _simulationStats{ internal::statsCapacity }
+    {
+        ZEN_EXPECTS_MSG(options.tickRate != 0 && options.tickRate <= maxTickRate, u"TickRateOutOfRange");
+        ZEN_EXPECTS_MSG(options.frameRate <= maxFrameRate, u"FrameRateOutOfRange");
+        ZEN_MEMORY_SCOPE(simulationMemoryTag);
+        internal::initializeBodies(_current);
+        internal::initializeBodies(_previous);
+    }
+
+    int FrameLoop::run(const std::atomic<bool>& exitRequested)
+    {
+        Clock::time_point previousFrameStart{ Clock::now() };
+        Clock::time_point nextFrameStart{ previousFrameStart };
+        Clock::duration accumulator{ 0 };
+
+        for (uint64_t frameIndex = 0; ; ++frameIndex) {
+            if (exitRequested.load(std::memory_order_relaxed)) {
+                break;
+            }
+            if (_options.frameCount != 0 && frameIndex >= _options.frameCount) {
+                break;
+            }
+
+            const Clock::time_point frameStart{ Clock::now() };
+            const Clock::duration elapsed{ frameStart - previousFrameStart };
+            if (frameIndex > 0) {
+                _frameStats.record(elapsed);
+            }
+            previousFrameStart = frameStart;
+
+            if (_options.benchmark) {
+                // 計測結果を再現可能にするため、ベンチマークでは実時間によらず1フレーム分の固定時間を進める。
+                // フレームレートとティックレートが異なれば、フレームはティックの間に入り補間される。
+                accumulator += (_frameDuration > Clock::duration::zero()) ? _frameDuration : _tickDuration;
+            }
+            else {
+                // 処理が追いつかない場合に、ティックが増えてさらに遅れることを防ぐため、1フレームで進める時間を制限する。
+                accumulator += std::min<Clock::duration>(elapsed, internal::maxFrameDelta);
+            }
+            // 1フレームに多くのティックが必要な場合でも、終了要求にはすぐ応じる。
+            while (accumulator >= _tickDuration && !exitRequested.load(std::memory_order_relaxed)) {
+                simulate();
+                accumulator -= _tickDuration;
+            }
+            const float alpha{ std::min(static_cast<float>(accumulator.count()) / static_cast<float>(_tickDuration.count()), 1.0f) };
+            _simulationStats.record(Clock::now() - frameStart);
+
+            // フレームNの出力が別スレッドで続いている間に、次のフレームのシミュレーションへ進む。
+            FrameState& frame{ _output.acquire(frameIndex) };
+            frame.frameIndex = frameIndex;
+            frame.tick = _current.tick;
+            frame.alpha = alpha;
+            frame.previousPositions = _previous.positions;
+            frame.currentPositions = _current.positions;
+            _output.submit(frameIndex);
+            ++_frameCount;
+
+            if (!_options.benchmark && _frameDuration > Clock::duration::zero()) {
+                nextFrameStart += _frameDuration;
+                const Clock::time_point now{ Clock::now() };
+                if (nextFrameStart + _frameDuration < now) {
+                    nextFrameStart = now;
+                }
+                else {
+                    std::this_thread::sleep_until(nextFrameStart);
+                }
+            }
+        }
+
+        _output.flush();
+        if (_options.benchmark) {
+            printStats();
+        }
+        return 0;
+    }
+
+    void FrameLoop::simulate()
+    {
+        // 最新の状態を一つ前の状態とし、そこから次のティックを計算する。
+        std::swap(_previous, _current);
+
+        ZEN_MEMORY_SCOPE(simulationMemoryTag);
+
+        const float deltaTime{ std::chrono::duration<float>(_tickDuration).count() };
+        const Vector3f acceleration{ 0.0f, internal::gravity, 0.0f };
+        const size_t count{ _previous.positions.size() };
+        for (size_t i = 0; i < count; ++i) {
+            Vector3f velocity{ _previous.velocities[i] + acceleration * deltaTime };
+            Vector3f position{ _previous.positions[i] + velocity * deltaTime };
+            if (position.getY() < 0.0f) {
+                position.setY(-position.getY());
+                velocity.setY(-velocity.getY() * internal::restitution);
+            }
+            _current.positions[i] = position;
+            _current.velocities[i] = velocity;
+        }
+        _current.tick = _previous.tick + 1;
+    }
+
+    void FrameLoop::printStats() const
+    {
+        std::printf("frames: %llu, ticks: %llu, tick rate: %u Hz, frame rate: %u Hz, checksum: %f\n",
+            static_cast<unsigned long long>(_frameCount),
+            static_cast<unsigned long long>(_current.tick),
+            _options.tickRate,
+            _options.frameRate,
+            _output.getChecksum());
+        std::printf("%-12s %10s %10s %10s %10s %10s %10s %10s\n", "(ms)", "min", "mean", "p50", "p90", "p99", "max", "jitter");
+        internal::printSummary("frame", _frameStats.summarize());
+        internal::printSummary("simulation", _simulationStats.summarize());
+        internal::printSummary("output", _output.getStats().summarize());
+    }
+}
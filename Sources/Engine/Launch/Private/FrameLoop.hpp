@@ -0,0 +1,134 @@
+#pragma once
+#include "FrameStats.hpp"
+#include "Main.hpp"
+#include <Math/Vector3.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zen
+{
+    /**
+    * @brief 固定タイムステップで更新されるシミュレーションの状態。
+    */
+    struct SimulationState final
+    {
+        uint64_t tick{ 0 };                 ///< 更新済みのティック数
+        std::vector<Vector3f> positions;    ///< 各ボディの位置
+        std::vector<Vector3f> velocities;   ///< 各ボディの速度
+    };
+
+    /**
+    * @brief シミュレーションから出力ステージへ受け渡すフレームの状態。
+    *
+    * 補間のため、直前と最新のティックの位置を両方保持します。
+    */
+    struct FrameState final
+    {
+        uint64_t frameIndex{ 0 };                   ///< フレーム番号
+        uint64_t tick{ 0 };                         ///< 最新のティック番号
+        float alpha{ 0.0f };                        ///< previousからcurrentへの補間係数
+        std::vector<Vector3f> previousPositions;    ///< 一つ前のティックの位置
+        std::vector<Vector3f> currentPositions;     ///< 最新のティックの位置
+    };
+
+    /**
+    * @brief フレームNの出力とフレームN+1のシミュレーションを並行させるためのステージ。
+    *
+    * FrameStateをダブルバッファで保持し、専用スレッドで補間とポストプロセスを行います。
+    * シミュレーション側はacquire()で書き込み先を受け取り、submit()で出力ステージに渡します。
+    */
+    class OutputStage final
+    {
+    public:
+        OutputStage();
+        ~OutputStage();
+
+        OutputStage(const OutputStage&) = delete;
+        OutputStage& operator=(const OutputStage&) = delete;
+
+        /**
+        * @brief frameIndexのフレームを書き込むバッファを取得します。
+        *
+        * 同じバッファを使う二つ前のフレームの出力が終わるまで待機します。
+        */
+        [[nodiscard]] FrameState& acquire(uint64_t frameIndex);
+
+        /**
+        * @brief acquire()で取得したバッファを出力ステージへ渡します。
+        */
+        void submit(uint64_t frameIndex);
+
+        /**
+        * @brief 渡したすべてのフレームの出力が終わるまで待機します。
+        */
+        void flush();
+
+        /**
+        * @brief 出力ステージの処理時間の統計を取得します。flush()後に呼び出してください。
+        */
+        [[nodiscard]] const FrameStats& getStats() const noexcept;
+
+        /**
+        * @brief 最後に出力したフレームのチェックサムを取得します。flush()後に呼び出してください。
+        */
+        [[nodiscard]] double getChecksum() const noexcept;
+
+    private:
+        void run();
+        void process(const FrameState& frame);
+
+        std::array<FrameState, 2> _frames;      ///< ダブルバッファ
+        std::vector<Vector3f> _interpolated;    ///< 補間後の位置
+        FrameStats _stats;                      ///< 出力ステージの処理時間
+        double _checksum{ 0.0 };                ///< 出力結果のチェックサム
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        uint64_t _submittedCount{ 0 };          ///< 渡されたフレーム数
+        uint64_t _completedCount{ 0 };          ///< 出力が終わったフレーム数
+        bool _exit{ false };
+        std::thread _thread;
+    };
+
+    /**
+    * @brief 補間付き固定タイムステップのメインループ。
+    *
+    * ティックとフレームは独立しており、フレームは直前の2ティックの間を補間して出力します。
+    * 通常モードでは実時間に合わせてティックを進め、フレームレートでフレームを刻みます。
+    * ベンチマークモードでは待機せずに1フレームにつき1/フレームレート秒ずつ進め、終了時に統計を出力します。
+    */
+    class FrameLoop final
+    {
+    public:
+        explicit FrameLoop(const LaunchOptions& options);
+
+        /**
+        * @brief フレーム数に達するか、終了が要求されるまでループを実行します。
+        *
+        * @return プロセスの終了コード
+        */
+        int run(const std::atomic<bool>& exitRequested);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void simulate();
+        void printStats() const;
+
+        LaunchOptions _options;
+        Clock::duration _tickDuration;      ///< 1ティックの長さ
+        Clock::duration _frameDuration;     ///< 1フレームの長さ。0の場合は上限なし
+        SimulationState _previous;          ///< 一つ前のティックの状態
+        SimulationState _current;           ///< 最新のティックの状態
+        OutputStage _output;
+        FrameStats _frameStats;             ///< フレーム間隔
+        FrameStats _simulationStats;        ///< シミュレーションの処理時間
+        uint64_t _frameCount{ 0 };          ///< 実行したフレーム数
+    };
+}
@@ -0,0 +1,77 @@
+#include "FrameStats.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            constexpr double nanosecondsToMilliseconds{ 1.0e-6 };
+
+            /**
+            * @brief ソート済みの配列から最近傍ランク法でパーセンタイルを求めます。
+            */
+            double percentile(const std::vector<int64_t>& sorted, const double rank)
+            {
+                const size_t index{ static_cast<size_t>(std::ceil(rank * static_cast<double>(sorted.size()))) };
+                return static_cast<double>(sorted[std::clamp<size_t>(index, 1, sorted.size()) - 1]) * nanosecondsToMilliseconds;
+            }
+        }
+    }
+
+    FrameStats::FrameStats(const size_t capacity)
+        : _capacity{ std::max<size_t>(capacity, 1) }
+    {
+        _samples.reserve(_capacity);
+    }
+
+    void FrameStats::record(const Duration duration)
+    {
+        if (_samples.size() < _capacity) {
+            _samples.push_back(duration.count());
+        }
+        else {
+            _samples[_recordCount % _capacity] = duration.count();
+        }
+        ++_recordCount;
+    }
+
+    FrameStatsSummary FrameStats::summarize() const
+    {
+        FrameStatsSummary summary{};
+        if (_samples.empty()) {
+            return summary;
+        }
+
+        // ジッターは時系列順の差分から求めるため、リングバッファの先頭から辿る。
+        const size_t count{ _samples.size() };
+        const size_t oldest{ (_recordCount > _capacity) ? static_cast<size_t>(_recordCount % _capacity) : 0 };
+        double total{ 0.0 };
+        double jitterTotal{ 0.0 };
+        for (size_t i = 0; i < count; ++i) {
+            const int64_t sample{ _samples[(oldest + i) % count] };
+            total += static_cast<double>(sample);
+            if (i > 0) {
+                const int64_t previous{ _samples[(oldest + i - 1) % count] };
+                jitterTotal += std::abs(static_cast<double>(sample - previous));
+            }
+        }
+
+        std::vector<int64_t> sorted{ _samples };
+        std::sort(sorted.begin(), sorted.end());
+
+        summary.sampleCount = count;
+        summary.min = static_cast<double>(sorted.front()) * internal::nanosecondsToMilliseconds;
+        summary.max = static_cast<double>(sorted.back()) * internal::nanosecondsToMilliseconds;
+        summary.mean = total / static_cast<double>(count) * internal::nanosecondsToMilliseconds;
+        summary.p50 = internal::percentile(sorted, 0.50);
+        summary.p90 = internal::percentile(sorted, 0.90);
+        summary.p99 = internal::percentile(sorted, 0.99);
+        if (count > 1) {
+            summary.jitter = jitterTotal / static_cast<double>(count - 1) * internal::nanosecondsToMilliseconds;
+        }
+        return summary;
+    }
+}
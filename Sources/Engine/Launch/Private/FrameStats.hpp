@@ -0,0 +1,54 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zen
+{
+    /**
+    * @brief 計測区間の統計値。時間の単位はすべてミリ秒です。
+    */
+    struct FrameStatsSummary final
+    {
+        uint64_t sampleCount{ 0 };  ///< 集計に用いたサンプル数
+        double min{ 0.0 };          ///< 最小値
+        double mean{ 0.0 };         ///< 平均値
+        double p50{ 0.0 };          ///< 50パーセンタイル
+        double p90{ 0.0 };          ///< 90パーセンタイル
+        double p99{ 0.0 };          ///< 99パーセンタイル
+        double max{ 0.0 };          ///< 最大値
+        double jitter{ 0.0 };       ///< 連続するサンプル間の差の絶対値の平均
+    };
+
+    /**
+    * @brief フレーム単位の計測値を蓄積し、パーセンタイルとジッターを求めます。
+    *
+    * 無制限に実行される場合に備え、直近のcapacity個のサンプルのみをリングバッファに保持します。
+    */
+    class FrameStats final
+    {
+    public:
+        using Duration = std::chrono::nanoseconds;
+
+        /**
+        * @param[in] capacity 保持するサンプルの最大数
+        */
+        explicit FrameStats(size_t capacity);
+
+        /**
+        * @brief サンプルを一つ追加します。
+        */
+        void record(Duration duration);
+
+        /**
+        * @brief 保持しているサンプルから統計値を計算します。
+        */
+        [[nodiscard]] FrameStatsSummary summarize() const;
+
+    private:
+        std::vector<int64_t> _samples;  ///< 計測値(ナノ秒)のリングバッファ
+        size_t _capacity;               ///< リングバッファの容量
+        uint64_t _recordCount{ 0 };     ///< これまでに追加されたサンプル数
+    };
+}
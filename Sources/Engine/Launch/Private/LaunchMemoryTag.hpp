@@ -0,0 +1,10 @@
+#pragma once
+#include <Core/Memory/MemoryTracker.hpp>
+
+namespace zen
+{
+    // Launchが使うメモリタグ。名前はrunMain()で登録します。
+    inline constexpr MemoryTag launchMemoryTag{ makeUserMemoryTag(0) };        ///< 起動処理とモジュールの管理
+    inline constexpr MemoryTag simulationMemoryTag{ makeUserMemoryTag(1) };    ///< シミュレーションの状態
+    inline constexpr MemoryTag outputMemoryTag{ makeUserMemoryTag(2) };        ///< 出力ステージ
+}
@@ -0,0 +1,69 @@
+#include "Main.hpp"
+#include <charconv>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            template<typename T>
+            bool parseNumber(const std::string_view text, T& value)
+            {
+                const std::from_chars_result result{ std::from_chars(text.data(), text.data() + text.size(), value) };
+                return result.ec == std::errc{} && result.ptr == text.data() + text.size();
+            }
+        }
+    }
+
+    bool parseLaunchOptions(const std::span<const std::string_view> arguments, LaunchOptions& options)
+    {
+        constexpr std::string_view tickRateOption{ "--tick-rate=" };
+        constexpr std::string_view frameRateOption{ "--frame-rate=" };
+        constexpr std::string_view framesOption{ "--frames=" };
+        constexpr std::string_view benchmarkOption{ "--benchmark" };
+        constexpr std::string_view memorySnapshotOption{ "--memory-snapshot=" };
+
+        for (const std::string_view argument : arguments) {
+            if (argument.starts_with(tickRateOption)) {
+                if (!internal::parseNumber(argument.substr(tickRateOption.size()), options.tickRate) || options.tickRate == 0 || options.tickRate > maxTickRate) {
+                    return false;
+                }
+            }
+            else if (argument.starts_with(frameRateOption)) {
+                if (!internal::parseNumber(argument.substr(frameRateOption.size()), options.frameRate) || options.frameRate > maxFrameRate) {
+                    return false;
+                }
+            }
+            else if (argument.starts_with(framesOption)) {
+                if (!internal::parseNumber(argument.substr(framesOption.size()), options.frameCount)) {
+                    return false;
+                }
+            }
+            else if (argument == benchmarkOption) {
+                options.benchmark = true;
+            }
+            else if (argument.starts_with(memorySnapshotOption) && argument.size() > memorySnapshotOption.size()) {
+                options.memorySnapshotPath = argument.substr(memorySnapshotOption.size());
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const char* getLaunchUsage() noexcept
+    {
+        return
+            "  --tick-rate=<hz>   Simulation ticks per second, 1 to 10000 (default: 60)\n"
+            "  --frame-rate=<hz>  Frames per second up to 10000, 0 is uncapped (default: 120)\n"
+            "                     Frames falling between ticks are interpolated\n"
+            "  --frames=<count>   Number of frames to run, 0 runs until interrupted\n"
+            "  --benchmark        Run headless without frame pacing and print frame stats at exit.\n"
+            "                     Each frame advances simulated time by 1/frame-rate seconds\n"
+            "  --memory-snapshot=<path>\n"
+            "                     Write memory usage per tag to <path> every second\n"
+            "                     (requires ZEN_ENABLE_MEMORY_TRACKING)\n";
+    }
+}
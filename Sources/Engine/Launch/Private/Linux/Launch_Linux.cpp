@@ -1,6 +1,42 @@
 #include "./../Main.hpp"
+#include <Core/Memory/MemoryTracker.hpp>
+#include <csignal>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            void onSignal([[maybe_unused]] int signal)
+            {
+                zen::requestExit();
+            }
+        }
+    }
+}
 
 int main(int argc, char** argv)
 {
-    return zen::runMain();
-}
\ No newline at end of file
+    int exitCode{ 0 };
+    {
+        zen::LaunchOptions options{};
+        const std::vector<std::string_view> arguments(argv + 1, argv + argc);
+        if (!zen::parseLaunchOptions(arguments, options)) {
+            std::fprintf(stderr, "Usage: %s [options]\n%s", argv[0], zen::getLaunchUsage());
+            return 1;
+        }
+
+        std::signal(SIGINT, zen::internal::onSignal);
+        std::signal(SIGTERM, zen::internal::onSignal);
+
+        exitCode = zen::runMain(options);
+    }
+
+    // 起動オプションも破棄した後なので、残っているメモリはすべて解放漏れとして報告する。
+    ZEN_MEMORY_REPORT_LEAKS(stderr);
+    return exitCode;
+}
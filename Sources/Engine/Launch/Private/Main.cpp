@@ -1,12 +1,89 @@
 #include "Main.hpp"
+#include "FrameLoop.hpp"
+#include "LaunchMemoryTag.hpp"
+#include <Core/Module/CoreModule.hpp>
+#include <Core/Module/ModuleRegistry.hpp>
+#include <Math/MathModule.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
 
 namespace zen
 {
-    int runMain()
+    namespace internal
+    {
+        namespace
+        {
+            std::atomic<bool> exitRequested{ false };
+
+            void printStartupTimings(const ModuleRegistry& registry)
+            {
+                constexpr double nanosecondsToMilliseconds{ 1.0e-6 };
+                std::printf("startup: %.4f ms\n", static_cast<double>(registry.getStartupDuration().count()) * nanosecondsToMilliseconds);
+                std::printf("%-12s %10s %10s %8s\n", "(ms)", "start", "duration", "worker");
+                for (const ModuleTiming& timing : registry.getStartupTimings()) {
+                    std::printf("%-12s %10.4f %10.4f %8u\n",
+                        timing.name.c_str(),
+                        static_cast<double>(timing.start.count()) * nanosecondsToMilliseconds,
+                        static_cast<double>(timing.duration.count()) * nanosecondsToMilliseconds,
+                        timing.workerIndex);
+                }
+            }
+        }
+    }
+
+    int runMain(const LaunchOptions& options)
     {
         // @TODO プロセスのアタッチ待ちができるようにする。
 
+        ZEN_MEMORY_REGISTER_TAG(launchMemoryTag, "Launch");
+        ZEN_MEMORY_REGISTER_TAG(simulationMemoryTag, "Simulation");
+        ZEN_MEMORY_REGISTER_TAG(outputMemoryTag, "Output");
+
+        if (!options.memorySnapshotPath.empty()) {
+#if ZEN_MEMORY_TRACKING
+            if (!ZEN_MEMORY_BEGIN_CAPTURE(options.memorySnapshotPath.c_str(), std::chrono::seconds{ 1 })) {
+                std::fprintf(stderr, "Failed to open memory snapshot file '%s'\n", options.memorySnapshotPath.c_str());
+                return 1;
+            }
+#else
+            std::fprintf(stderr, "--memory-snapshot requires a build with ZEN_ENABLE_MEMORY_TRACKING\n");
+            return 1;
+#endif
+        }
+
+        int exitCode{ 0 };
+        {
+            ZEN_MEMORY_SCOPE(launchMemoryTag);
 
-        return 0;
+            ModuleRegistry registry{};
+            registry.add(makeCoreModule());
+            registry.add(makeMathModule());
+
+            if (!registry.startup(std::thread::hardware_concurrency())) {
+                std::fprintf(stderr, "%s\n", registry.getError().c_str());
+                exitCode = 1;
+            }
+            else {
+                if (options.benchmark) {
+                    internal::printStartupTimings(registry);
+                }
+
+                {
+                    FrameLoop loop{ options };
+                    exitCode = loop.run(internal::exitRequested);
+                }
+                registry.shutdown();
+            }
+        }
+
+        ZEN_MEMORY_END_CAPTURE();
+        return exitCode;
+    }
+
+    void requestExit() noexcept
+    {
+        internal::exitRequested.store(true, std::memory_order_relaxed);
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,53 @@
 #pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
 
 namespace zen
 {
-    int runMain();
-}
\ No newline at end of file
+    // 1ティック、1フレームの長さがナノ秒単位で十分な精度を持つように、レートの上限を設ける。
+    inline constexpr uint32_t maxTickRate{ 10000 };
+    inline constexpr uint32_t maxFrameRate{ 10000 };
+
+    /**
+    * @brief 起動時に指定されるメインループの設定。
+    */
+    struct LaunchOptions final
+    {
+        uint32_t tickRate{ 60 };    ///< 1秒あたりのシミュレーション更新回数。1以上maxTickRate以下
+        uint32_t frameRate{ 120 };  ///< 1秒あたりのフレーム数。maxFrameRate以下で、0の場合は上限を設けません。
+        uint64_t frameCount{ 0 };   ///< 実行するフレーム数。0の場合は終了が要求されるまで実行します。
+        bool benchmark{ false };    ///< ヘッドレスのベンチマークモードで実行し、終了時に統計を出力するか
+        std::string memorySnapshotPath; ///< メモリ使用量を定期的に書き出すファイル。空の場合は書き出しません。
+    };
+
+    /**
+    * @brief コマンドライン引数から起動設定を読み取ります。
+    *
+    * @param[in] arguments プログラム名を除いたコマンドライン引数
+    * @param[in,out] options 読み取った値で上書きする起動設定
+    *
+    * @return 不明な引数や不正な値がなければtrue
+    */
+    [[nodiscard]] bool parseLaunchOptions(std::span<const std::string_view> arguments, LaunchOptions& options);
+
+    /**
+    * @brief parseLaunchOptions()が受け付ける引数の説明を取得します。
+    */
+    [[nodiscard]] const char* getLaunchUsage() noexcept;
+
+    /**
+    * @brief エンジンのメインループを実行します。
+    *
+    * @param[in] options 起動設定
+    *
+    * @return プロセスの終了コード
+    */
+    int runMain(const LaunchOptions& options);
+
+    /**
+    * @brief メインループに終了を要求します。シグナルハンドラーからも呼び出せます。
+    */
+    void requestExit() noexcept;
+}
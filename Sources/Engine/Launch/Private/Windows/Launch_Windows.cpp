@@ -1,5 +1,49 @@
 #include "./../Main.hpp"
+#include <Core/Memory/MemoryTracker.hpp>
 #include <Windows.h>
+#include <shellapi.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            // ウィンドウもコンソールも持たないため、外部から終了させる手段がない。
+            // そのため終了条件のない実行は受け付けず、フレーム数の既定値も有限にする。
+            constexpr uint64_t defaultFrameCount{ 600 };
+
+            std::string toUtf8(const std::wstring_view text)
+            {
+                const int size{ WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr) };
+                std::string result(static_cast<size_t>(size), '\0');
+                WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), result.data(), size, nullptr, nullptr);
+                return result;
+            }
+
+            bool parseCommandLine(LaunchOptions& options)
+            {
+                int argc{ 0 };
+                LPWSTR* argv{ CommandLineToArgvW(GetCommandLineW(), &argc) };
+                if (argv == nullptr) {
+                    return false;
+                }
+
+                std::vector<std::string> storage;
+                for (int i = 1; i < argc; ++i) {
+                    storage.push_back(toUtf8(argv[i]));
+                }
+                LocalFree(argv);
+
+                const std::vector<std::string_view> arguments(storage.begin(), storage.end());
+                return parseLaunchOptions(arguments, options) && options.frameCount != 0;
+            }
+        }
+    }
+}
 
 int WINAPI wWinMain(
     [[maybe_unused]] _In_ HINSTANCE hInstance,
@@ -7,6 +51,20 @@ int WINAPI wWinMain(
     [[maybe_unused]] _In_ LPWSTR lpCmdLine,
     [[maybe_unused]] _In_ int nCmdShow)
 {
-    return zen::runMain();
-}
+    int exitCode{ 0 };
+    {
+        zen::LaunchOptions options{};
+        options.frameCount = zen::internal::defaultFrameCount;
+        if (!zen::internal::parseCommandLine(options)) {
+            const std::string usage{ std::string{ "Usage: Launch [options]\n--frames must be greater than 0 on Windows.\n\n" } + zen::getLaunchUsage() };
+            MessageBoxA(nullptr, usage.c_str(), "Launch", MB_OK | MB_ICONERROR);
+            return 1;
+        }
 
+        exitCode = zen::runMain(options);
+    }
+
+    // 起動オプションも破棄した後なので、残っているメモリはすべて解放漏れとして報告する。
+    ZEN_MEMORY_REPORT_LEAKS(stderr);
+    return exitCode;
+}
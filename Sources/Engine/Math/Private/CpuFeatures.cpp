@@ -0,0 +1,86 @@
+#include "CpuFeatures.hpp"
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            struct CpuidResult final
+            {
+                uint32_t eax{ 0 };
+                uint32_t ebx{ 0 };
+                uint32_t ecx{ 0 };
+                uint32_t edx{ 0 };
+            };
+
+            CpuidResult cpuid(const uint32_t leaf, const uint32_t subleaf) noexcept
+            {
+                CpuidResult result{};
+#if defined(_MSC_VER)
+                int info[4]{};
+                __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+                result.eax = static_cast<uint32_t>(info[0]);
+                result.ebx = static_cast<uint32_t>(info[1]);
+                result.ecx = static_cast<uint32_t>(info[2]);
+                result.edx = static_cast<uint32_t>(info[3]);
+#else
+                if (__get_cpuid_max(0, nullptr) < leaf) {
+                    return result;
+                }
+                __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+                return result;
+            }
+
+            uint64_t readExtendedControlRegister() noexcept
+            {
+#if defined(_MSC_VER)
+                return _xgetbv(0);
+#else
+                uint32_t eax{ 0 };
+                uint32_t edx{ 0 };
+                __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+                return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+            }
+
+            bool detectAvx2() noexcept
+            {
+                constexpr uint32_t osxsaveBit{ 1u << 27 };
+                constexpr uint32_t avxBit{ 1u << 28 };
+                constexpr uint32_t avx2Bit{ 1u << 5 };
+                constexpr uint64_t ymmStateMask{ 0x6 };
+
+                const CpuidResult features{ cpuid(1, 0) };
+                if ((features.ecx & osxsaveBit) == 0 || (features.ecx & avxBit) == 0) {
+                    return false;
+                }
+                if ((readExtendedControlRegister() & ymmStateMask) != ymmStateMask) {
+                    return false;
+                }
+                return (cpuid(7, 0).ebx & avx2Bit) != 0;
+            }
+        }
+
+        bool isSse41Supported() noexcept
+        {
+            constexpr uint32_t sse41Bit{ 1u << 19 };
+            return (cpuid(1, 0).ecx & sse41Bit) != 0;
+        }
+
+        bool isAvx2Supported() noexcept
+        {
+            static const bool supported{ detectAvx2() };
+            return supported;
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace zen
+{
+    namespace internal
+    {
+        /**
+        * @brief Vector4fが利用するSSE4.1命令が実行できるかを調べます。
+        */
+        [[nodiscard]] bool isSse41Supported() noexcept;
+
+        /**
+        * @brief AVX2命令が実行でき、OSがYMMレジスタを保存するかを調べます。結果は初回呼び出し時に確定します。
+        */
+        [[nodiscard]] bool isAvx2Supported() noexcept;
+    }
+}
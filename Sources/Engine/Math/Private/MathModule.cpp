@@ -0,0 +1,20 @@
+#include <Math/MathModule.hpp>
+#include "CpuFeatures.hpp"
+
+namespace zen
+{
+    ModuleDescriptor makeMathModule()
+    {
+        return ModuleDescriptor{
+            "Math",
+            { "Core" },
+            [] {
+                // ノイズのバッチ評価が使う命令セットの判定を、起動時に済ませておく。
+                static_cast<void>(internal::isAvx2Supported());
+                return internal::isSse41Supported();
+            },
+            nullptr,
+            MemoryTag::Math
+        };
+    }
+}
@@ -0,0 +1,145 @@
+#include <Math/PerlinNoise.hpp>
+#include <Math/Random.hpp>
+#include <Core/Misc/Assert.hpp>
+#include "CpuFeatures.hpp"
+#include "PerlinNoiseAvx2.hpp"
+#include <cmath>
+#include <utility>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            // バッチ評価と結果を一致させるため、演算の順序はPerlinNoiseAvx2.cppと揃えておくこと。
+
+            ZEN_FORCEINLINE float fade(const float t) noexcept
+            {
+                const float cube{ t * t * t };
+                return cube * (t * (t * 6.0f - 15.0f) + 10.0f);
+            }
+
+            ZEN_FORCEINLINE float lerp(const float a, const float b, const float t) noexcept
+            {
+                return a + t * (b - a);
+            }
+
+            ZEN_FORCEINLINE float gradient2(const int32_t hash, const float x, const float y) noexcept
+            {
+                const int32_t h{ hash & 3 };
+                return ((h & 1) == 0 ? x : -x) + ((h & 2) == 0 ? y : -y);
+            }
+
+            ZEN_FORCEINLINE float gradient3(const int32_t hash, const float x, const float y, const float z) noexcept
+            {
+                const int32_t h{ hash & 15 };
+                const float u{ h < 8 ? x : y };
+                const float v{ h < 4 ? y : ((h == 12 || h == 14) ? x : z) };
+                return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+            }
+        }
+    }
+
+    PerlinNoise::PerlinNoise(const uint64_t seed) noexcept
+    {
+        std::array<uint32_t, 256> randomValues;
+        Random random{ seed };
+        random.fillUInts(randomValues);
+
+        for (int32_t i = 0; i < 256; ++i) {
+            _permutation[i] = i;
+        }
+        for (int32_t i = 255; i > 0; --i) {
+            const int32_t j{ static_cast<int32_t>((static_cast<uint64_t>(randomValues[i]) * static_cast<uint64_t>(i + 1)) >> 32) };
+            std::swap(_permutation[i], _permutation[j]);
+        }
+        for (int32_t i = 0; i < 256; ++i) {
+            _permutation[i + 256] = _permutation[i];
+        }
+    }
+
+    float PerlinNoise::evaluate(float x, float y) const noexcept
+    {
+        const float floorX{ std::floor(x) };
+        const float floorY{ std::floor(y) };
+        const int32_t cellX{ static_cast<int32_t>(floorX) & 255 };
+        const int32_t cellY{ static_cast<int32_t>(floorY) & 255 };
+        x -= floorX;
+        y -= floorY;
+        const float u{ internal::fade(x) };
+        const float v{ internal::fade(y) };
+
+        const int32_t a{ _permutation[cellX] + cellY };
+        const int32_t b{ _permutation[cellX + 1] + cellY };
+
+        const float g00{ internal::gradient2(_permutation[a], x, y) };
+        const float g10{ internal::gradient2(_permutation[b], x - 1.0f, y) };
+        const float g01{ internal::gradient2(_permutation[a + 1], x, y - 1.0f) };
+        const float g11{ internal::gradient2(_permutation[b + 1], x - 1.0f, y - 1.0f) };
+
+        return internal::lerp(internal::lerp(g00, g10, u), internal::lerp(g01, g11, u), v);
+    }
+
+    float PerlinNoise::evaluate(float x, float y, float z) const noexcept
+    {
+        const float floorX{ std::floor(x) };
+        const float floorY{ std::floor(y) };
+        const float floorZ{ std::floor(z) };
+        const int32_t cellX{ static_cast<int32_t>(floorX) & 255 };
+        const int32_t cellY{ static_cast<int32_t>(floorY) & 255 };
+        const int32_t cellZ{ static_cast<int32_t>(floorZ) & 255 };
+        x -= floorX;
+        y -= floorY;
+        z -= floorZ;
+        const float u{ internal::fade(x) };
+        const float v{ internal::fade(y) };
+        const float w{ internal::fade(z) };
+
+        const int32_t a{ _permutation[cellX] + cellY };
+        const int32_t aa{ _permutation[a] + cellZ };
+        const int32_t ab{ _permutation[a + 1] + cellZ };
+        const int32_t b{ _permutation[cellX + 1] + cellY };
+        const int32_t ba{ _permutation[b] + cellZ };
+        const int32_t bb{ _permutation[b + 1] + cellZ };
+
+        const float g000{ internal::gradient3(_permutation[aa], x, y, z) };
+        const float g100{ internal::gradient3(_permutation[ba], x - 1.0f, y, z) };
+        const float g010{ internal::gradient3(_permutation[ab], x, y - 1.0f, z) };
+        const float g110{ internal::gradient3(_permutation[bb], x - 1.0f, y - 1.0f, z) };
+        const float g001{ internal::gradient3(_permutation[aa + 1], x, y, z - 1.0f) };
+        const float g101{ internal::gradient3(_permutation[ba + 1], x - 1.0f, y, z - 1.0f) };
+        const float g011{ internal::gradient3(_permutation[ab + 1], x, y - 1.0f, z - 1.0f) };
+        const float g111{ internal::gradient3(_permutation[bb + 1], x - 1.0f, y - 1.0f, z - 1.0f) };
+
+        const float y0{ internal::lerp(internal::lerp(g000, g100, u), internal::lerp(g010, g110, u), v) };
+        const float y1{ internal::lerp(internal::lerp(g001, g101, u), internal::lerp(g011, g111, u), v) };
+        return internal::lerp(y0, y1, w);
+    }
+
+    void PerlinNoise::evaluate(const std::span<const float> xs, const std::span<const float> ys, const std::span<float> results) const noexcept
+    {
+        ZEN_EXPECTS(xs.size() == ys.size() && ys.size() == results.size());
+        const size_t count{ results.size() };
+        size_t i{ 0 };
+        if (internal::isAvx2Supported()) {
+            i = internal::evaluatePerlin2Avx2(_permutation.data(), xs.data(), ys.data(), results.data(), count);
+        }
+        for (; i < count; ++i) {
+            results[i] = evaluate(xs[i], ys[i]);
+        }
+    }
+
+    void PerlinNoise::evaluate(const std::span<const float> xs, const std::span<const float> ys, const std::span<const float> zs, const std::span<float> results) const noexcept
+    {
+        ZEN_EXPECTS(xs.size() == ys.size() && ys.size() == zs.size() && zs.size() == results.size());
+        const size_t count{ results.size() };
+        size_t i{ 0 };
+        if (internal::isAvx2Supported()) {
+            i = internal::evaluatePerlin3Avx2(_permutation.data(), xs.data(), ys.data(), zs.data(), results.data(), count);
+        }
+        for (; i < count; ++i) {
+            results[i] = evaluate(xs[i], ys[i], zs[i]);
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#include "PerlinNoiseAvx2.hpp"
+#include <immintrin.h>
+
+// このファイルだけをAVX2向けにコンパイルする。インライン関数を持つヘッダーを含めると、
+// AVX2版の実体がリンク時に他の翻訳単位へ選ばれる恐れがあるため、intrinsic以外は含めないこと。
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            // 演算の順序はPerlinNoise.cppのスカラー版と揃えておくこと。
+
+            inline __m256 fade(const __m256 t) noexcept
+            {
+                const __m256 cube{ _mm256_mul_ps(_mm256_mul_ps(t, t), t) };
+                const __m256 inner{ _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f)) };
+                return _mm256_mul_ps(cube, inner);
+            }
+
+            inline __m256 lerp(const __m256 a, const __m256 b, const __m256 t) noexcept
+            {
+                return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+            }
+
+            /**
+            * @brief hashの指定したビットが立っているレーンの符号を反転します。
+            */
+            inline __m256 negateIf(const __m256 value, const __m256i hash, const int32_t bit) noexcept
+            {
+                const __m256i mask{ _mm256_and_si256(hash, _mm256_set1_epi32(bit)) };
+                const __m256i sign{ _mm256_slli_epi32(_mm256_cmpeq_epi32(mask, _mm256_set1_epi32(bit)), 31) };
+                return _mm256_xor_ps(value, _mm256_castsi256_ps(sign));
+            }
+
+            inline __m256 gradient2(const __m256i hash, const __m256 x, const __m256 y) noexcept
+            {
+                return _mm256_add_ps(negateIf(x, hash, 1), negateIf(y, hash, 2));
+            }
+
+            inline __m256 gradient3(const __m256i hash, const __m256 x, const __m256 y, const __m256 z) noexcept
+            {
+                const __m256i h{ _mm256_and_si256(hash, _mm256_set1_epi32(15)) };
+                const __m256 lessThan8{ _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h)) };
+                const __m256 lessThan4{ _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h)) };
+                const __m256 is12or14{ _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)), _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14)))) };
+
+                const __m256 u{ _mm256_blendv_ps(y, x, lessThan8) };
+                const __m256 v{ _mm256_blendv_ps(_mm256_blendv_ps(z, x, is12or14), y, lessThan4) };
+                return _mm256_add_ps(negateIf(u, h, 1), negateIf(v, h, 2));
+            }
+
+            inline __m256i lookup(const int32_t* permutation, const __m256i index) noexcept
+            {
+                return _mm256_i32gather_epi32(permutation, index, 4);
+            }
+        }
+
+        size_t evaluatePerlin2Avx2(const int32_t* permutation, const float* xs, const float* ys, float* results, const size_t count) noexcept
+        {
+            const __m256i cellMask{ _mm256_set1_epi32(255) };
+            const __m256i oneIndex{ _mm256_set1_epi32(1) };
+            const __m256 one{ _mm256_set1_ps(1.0f) };
+
+            size_t i{ 0 };
+            for (; i + 8 <= count; i += 8) {
+                __m256 x{ _mm256_loadu_ps(xs + i) };
+                __m256 y{ _mm256_loadu_ps(ys + i) };
+                const __m256 floorX{ _mm256_floor_ps(x) };
+                const __m256 floorY{ _mm256_floor_ps(y) };
+                const __m256i cellX{ _mm256_and_si256(_mm256_cvttps_epi32(floorX), cellMask) };
+                const __m256i cellY{ _mm256_and_si256(_mm256_cvttps_epi32(floorY), cellMask) };
+                x = _mm256_sub_ps(x, floorX);
+                y = _mm256_sub_ps(y, floorY);
+                const __m256 u{ fade(x) };
+                const __m256 v{ fade(y) };
+
+                const __m256i a{ _mm256_add_epi32(lookup(permutation, cellX), cellY) };
+                const __m256i b{ _mm256_add_epi32(lookup(permutation, _mm256_add_epi32(cellX, oneIndex)), cellY) };
+
+                const __m256 xMinusOne{ _mm256_sub_ps(x, one) };
+                const __m256 yMinusOne{ _mm256_sub_ps(y, one) };
+                const __m256 g00{ gradient2(lookup(permutation, a), x, y) };
+                const __m256 g10{ gradient2(lookup(permutation, b), xMinusOne, y) };
+                const __m256 g01{ gradient2(lookup(permutation, _mm256_add_epi32(a, oneIndex)), x, yMinusOne) };
+                const __m256 g11{ gradient2(lookup(permutation, _mm256_add_epi32(b, oneIndex)), xMinusOne, yMinusOne) };
+
+                _mm256_storeu_ps(results + i, lerp(lerp(g00, g10, u), lerp(g01, g11, u), v));
+            }
+            return i;
+        }
+
+        size_t evaluatePerlin3Avx2(const int32_t* permutation, const float* xs, const float* ys, const float* zs, float* results, const size_t count) noexcept
+        {
+            const __m256i cellMask{ _mm256_set1_epi32(255) };
+            const __m256i oneIndex{ _mm256_set1_epi32(1) };
+            const __m256 one{ _mm256_set1_ps(1.0f) };
+
+            size_t i{ 0 };
+            for (; i + 8 <= count; i += 8) {
+                __m256 x{ _mm256_loadu_ps(xs + i) };
+                __m256 y{ _mm256_loadu_ps(ys + i) };
+                __m256 z{ _mm256_loadu_ps(zs + i) };
+                const __m256 floorX{ _mm256_floor_ps(x) };
+                const __m256 floorY{ _mm256_floor_ps(y) };
+                const __m256 floorZ{ _mm256_floor_ps(z) };
+                const __m256i cellX{ _mm256_and_si256(_mm256_cvttps_epi32(floorX), cellMask) };
+                const __m256i cellY{ _mm256_and_si256(_mm256_cvttps_epi32(floorY), cellMask) };
+                const __m256i cellZ{ _mm256_and_si256(_mm256_cvttps_epi32(floorZ), cellMask) };
+                x = _mm256_sub_ps(x, floorX);
+                y = _mm256_sub_ps(y, floorY);
+                z = _mm256_sub_ps(z, floorZ);
+                const __m256 u{ fade(x) };
+                const __m256 v{ fade(y) };
+                const __m256 w{ fade(z) };
+
+                const __m256i a{ _mm256_add_epi32(lookup(permutation, cellX), cellY) };
+                const __m256i aa{ _mm256_add_epi32(lookup(permutation, a), cellZ) };
+                const __m256i ab{ _mm256_add_epi32(lookup(permutation, _mm256_add_epi32(a, oneIndex)), cellZ) };
+                const __m256i b{ _mm256_add_epi32(lookup(permutation, _mm256_add_epi32(cellX, oneIndex)), cellY) };
+                const __m256i ba{ _mm256_add_epi32(lookup(permutation, b), cellZ) };
+                const __m256i bb{ _mm256_add_epi32(lookup(permutation, _mm256_add_epi32(b, oneIndex)), cellZ) };
+
+                const __m256 xMinusOne{ _mm256_sub_ps(x, one) };
+                const __m256 yMinusOne{ _mm256_sub_ps(y, one) };
+                const __m256 zMinusOne{ _mm256_sub_ps(z, one) };
+                const __m256 g000{ gradient3(lookup(permutation, aa), x, y, z) };
+                const __m256 g100{ gradient3(lookup(permutation, ba), xMinusOne, y, z) };
+                const __m256 g010{ gradient3(lookup(permutation, ab), x, yMinusOne, z) };
+                const __m256 g110{ gradient3(lookup(permutation, bb), xMinusOne, yMinusOne, z) };
+                const __m256 g001{ gradient3(lookup(permutation, _mm256_add_epi32(aa, oneIndex)), x, y, zMinusOne) };
+                const __m256 g101{ gradient3(lookup(permutation, _mm256_add_epi32(ba, oneIndex)), xMinusOne, y, zMinusOne) };
+                const __m256 g011{ gradient3(lookup(permutation, _mm256_add_epi32(ab, oneIndex)), x, yMinusOne, zMinusOne) };
+                const __m256 g111{ gradient3(lookup(permutation, _mm256_add_epi32(bb, oneIndex)), xMinusOne, yMinusOne, zMinusOne) };
+
+                const __m256 y0{ lerp(lerp(g000, g100, u), lerp(g010, g110, u), v) };
+                const __m256 y1{ lerp(lerp(g001, g101, u), lerp(g011, g111, u), v) };
+                _mm256_storeu_ps(results + i, lerp(y0, y1, w));
+            }
+            return i;
+        }
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace zen
+{
+    namespace internal
+    {
+        /**
+        * @brief 2次元のパーリンノイズを8要素ずつ評価します。
+        *
+        * @pre AVX2が利用できなければいけません。
+        *
+        * @return 評価した要素数。8の倍数で、count以下です。
+        */
+        size_t evaluatePerlin2Avx2(const int32_t* permutation, const float* xs, const float* ys, float* results, size_t count) noexcept;
+
+        /**
+        * @brief 3次元のパーリンノイズを8要素ずつ評価します。
+        *
+        * @pre AVX2が利用できなければいけません。
+        *
+        * @return 評価した要素数。8の倍数で、count以下です。
+        */
+        size_t evaluatePerlin3Avx2(const int32_t* permutation, const float* xs, const float* ys, const float* zs, float* results, size_t count) noexcept;
+    }
+}
@@ -0,0 +1,214 @@
+#include <Math/Random.hpp>
+#include <Core/Misc/Assert.hpp>
+#include <algorithm>
+#include <numbers>
+
+namespace zen
+{
+    namespace internal
+    {
+        namespace
+        {
+            uint64_t splitMix64(uint64_t& state) noexcept
+            {
+                state += 0x9e3779b97f4a7c15ull;
+                uint64_t z{ state };
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31);
+            }
+
+            ZEN_FORCEINLINE __m128 toUnitFloat(const __m128i bits) noexcept
+            {
+                const __m128i mantissa{ _mm_or_si128(_mm_srli_epi32(bits, 9), _mm_set1_epi32(0x3f800000)) };
+                return _mm_sub_ps(_mm_castsi128_ps(mantissa), _mm_set1_ps(1.0f));
+            }
+
+            ZEN_FORCEINLINE __m128 select(const __m128 mask, const __m128 a, const __m128 b) noexcept
+            {
+                return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+            }
+
+            /**
+            * @brief [-π, π]の角度に対してsinとcosを同時に求めます。誤差は単精度の数ulp程度です。
+            */
+            ZEN_FORCEINLINE void sinCos(const __m128 angle, __m128& sine, __m128& cosine) noexcept
+            {
+                // π/2単位で象限を求め、[-π/4, π/4]に縮約してから多項式で近似する。
+                const __m128i quadrant{ _mm_cvtps_epi32(_mm_mul_ps(angle, _mm_set1_ps(std::numbers::inv_pi_v<float> * 2.0f))) };
+                const __m128 quadrantFloat{ _mm_cvtepi32_ps(quadrant) };
+                __m128 r{ _mm_sub_ps(angle, _mm_mul_ps(quadrantFloat, _mm_set1_ps(1.5707963705062866f))) };
+                r = _mm_sub_ps(r, _mm_mul_ps(quadrantFloat, _mm_set1_ps(-4.37113900018624283e-8f)));
+                const __m128 r2{ _mm_mul_ps(r, r) };
+
+                __m128 s{ _mm_add_ps(_mm_set1_ps(8.3321608736e-3f), _mm_mul_ps(r2, _mm_set1_ps(-1.9515295891e-4f))) };
+                s = _mm_add_ps(_mm_set1_ps(-1.6666654611e-1f), _mm_mul_ps(r2, s));
+                s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+
+                __m128 c{ _mm_add_ps(_mm_set1_ps(-1.388731625493765e-3f), _mm_mul_ps(r2, _mm_set1_ps(2.443315711809948e-5f))) };
+                c = _mm_add_ps(_mm_set1_ps(4.166664568298827e-2f), _mm_mul_ps(r2, c));
+                c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_mul_ps(_mm_mul_ps(r2, r2), c));
+
+                const __m128i one{ _mm_set1_epi32(1) };
+                const __m128 swap{ _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one)) };
+                const __m128 sineSign{ _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30)) };
+                const __m128 cosineSign{ _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), _mm_set1_epi32(2)), 30)) };
+                sine = _mm_xor_ps(select(swap, c, s), sineSign);
+                cosine = _mm_xor_ps(select(swap, s, c), cosineSign);
+            }
+
+            /**
+            * @brief [0, 1)の値に対して立方根を求めます。
+            */
+            ZEN_FORCEINLINE __m128 cubeRoot(const __m128 x) noexcept
+            {
+                // 指数部を1/3にした近似値から、ニュートン法で精度を上げる。
+                const __m128 bits{ _mm_cvtepi32_ps(_mm_castps_si128(x)) };
+                const __m128i guess{ _mm_add_epi32(_mm_cvttps_epi32(_mm_mul_ps(bits, _mm_set1_ps(1.0f / 3.0f))), _mm_set1_epi32(0x2a5137a0)) };
+                __m128 y{ _mm_castsi128_ps(guess) };
+                const __m128 oneThird{ _mm_set1_ps(1.0f / 3.0f) };
+                for (int32_t i = 0; i < 3; ++i) {
+                    y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(x, _mm_mul_ps(y, y))), oneThird);
+                }
+                return y;
+            }
+
+            ZEN_FORCEINLINE void unitVectors(const __m128 u0, const __m128 u1, __m128& x, __m128& y, __m128& z) noexcept
+            {
+                z = _mm_sub_ps(_mm_add_ps(u0, u0), _mm_set1_ps(1.0f));
+                const __m128 radius{ _mm_sqrt_ps(_mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(z, z)))) };
+                const __m128 angle{ _mm_mul_ps(_mm_sub_ps(_mm_add_ps(u1, u1), _mm_set1_ps(1.0f)), _mm_set1_ps(std::numbers::pi_v<float>)) };
+                __m128 sine;
+                __m128 cosine;
+                sinCos(angle, sine, cosine);
+                x = _mm_mul_ps(radius, cosine);
+                y = _mm_mul_ps(radius, sine);
+            }
+
+            /**
+            * @brief 4要素ずつ生成した値を書き込みます。端数は一時領域を経由して書き込みます。
+            */
+            template<typename Generator>
+            void fillSoA(const std::span<float> xs, const std::span<float> ys, const std::span<float> zs, Generator generator) noexcept
+            {
+                ZEN_EXPECTS(xs.size() == ys.size() && ys.size() == zs.size());
+                const size_t count{ xs.size() };
+                __m128 x;
+                __m128 y;
+                __m128 z;
+                size_t i{ 0 };
+                for (; i + 4 <= count; i += 4) {
+                    generator(x, y, z);
+                    _mm_storeu_ps(xs.data() + i, x);
+                    _mm_storeu_ps(ys.data() + i, y);
+                    _mm_storeu_ps(zs.data() + i, z);
+                }
+                if (i < count) {
+                    alignas(16) float tailX[4];
+                    alignas(16) float tailY[4];
+                    alignas(16) float tailZ[4];
+                    generator(x, y, z);
+                    _mm_store_ps(tailX, x);
+                    _mm_store_ps(tailY, y);
+                    _mm_store_ps(tailZ, z);
+                    std::copy(tailX, tailX + (count - i), xs.data() + i);
+                    std::copy(tailY, tailY + (count - i), ys.data() + i);
+                    std::copy(tailZ, tailZ + (count - i), zs.data() + i);
+                }
+            }
+        }
+    }
+
+    Random::Random(const uint64_t seed, const uint64_t stream) noexcept
+    {
+        uint64_t streamState{ stream };
+        uint64_t state{ seed ^ internal::splitMix64(streamState) };
+
+        alignas(16) uint32_t words[16];
+        for (int32_t i = 0; i < 16; i += 2) {
+            const uint64_t value{ internal::splitMix64(state) };
+            words[i] = static_cast<uint32_t>(value);
+            words[i + 1] = static_cast<uint32_t>(value >> 32);
+        }
+        _s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(words + 0));
+        _s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(words + 4));
+        _s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(words + 8));
+        _s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(words + 12));
+    }
+
+    Vector3f Random::nextUnitVector() noexcept
+    {
+        // 1回分の4レーンをレーン0に並べ替え、SoA版と同じ近似で計算する。
+        const __m128 u{ internal::toUnitFloat(nextUInt4()) };
+        __m128 x;
+        __m128 y;
+        __m128 z;
+        internal::unitVectors(u, _mm_shuffle_ps(u, u, _MM_SHUFFLE(1, 1, 1, 1)), x, y, z);
+        return Vector3f{ _mm_cvtss_f32(x), _mm_cvtss_f32(y), _mm_cvtss_f32(z) };
+    }
+
+    Vector3f Random::nextPointInSphere(const float radius) noexcept
+    {
+        const __m128 u{ internal::toUnitFloat(nextUInt4()) };
+        __m128 x;
+        __m128 y;
+        __m128 z;
+        internal::unitVectors(u, _mm_shuffle_ps(u, u, _MM_SHUFFLE(1, 1, 1, 1)), x, y, z);
+        const __m128 distance{ _mm_mul_ps(_mm_set1_ps(radius), internal::cubeRoot(_mm_shuffle_ps(u, u, _MM_SHUFFLE(2, 2, 2, 2)))) };
+        return Vector3f{ _mm_cvtss_f32(_mm_mul_ps(x, distance)), _mm_cvtss_f32(_mm_mul_ps(y, distance)), _mm_cvtss_f32(_mm_mul_ps(z, distance)) };
+    }
+
+    void Random::fillUInts(const std::span<uint32_t> values) noexcept
+    {
+        const size_t count{ values.size() };
+        size_t i{ 0 };
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values.data() + i), nextUInt4());
+        }
+        if (i < count) {
+            alignas(16) uint32_t tail[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(tail), nextUInt4());
+            std::copy(tail, tail + (count - i), values.data() + i);
+        }
+    }
+
+    void Random::fillFloats(const std::span<float> values, const float min, const float max) noexcept
+    {
+        const __m128 offset{ _mm_set1_ps(min) };
+        const __m128 scale{ _mm_set1_ps(max - min) };
+        const size_t count{ values.size() };
+        size_t i{ 0 };
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(values.data() + i, _mm_add_ps(offset, _mm_mul_ps(internal::toUnitFloat(nextUInt4()), scale)));
+        }
+        if (i < count) {
+            alignas(16) float tail[4];
+            _mm_store_ps(tail, _mm_add_ps(offset, _mm_mul_ps(internal::toUnitFloat(nextUInt4()), scale)));
+            std::copy(tail, tail + (count - i), values.data() + i);
+        }
+    }
+
+    void Random::fillUnitVectors(const std::span<float> xs, const std::span<float> ys, const std::span<float> zs) noexcept
+    {
+        internal::fillSoA(xs, ys, zs, [this](__m128& x, __m128& y, __m128& z) {
+            const __m128 u0{ internal::toUnitFloat(nextUInt4()) };
+            const __m128 u1{ internal::toUnitFloat(nextUInt4()) };
+            internal::unitVectors(u0, u1, x, y, z);
+        });
+    }
+
+    void Random::fillPointsInSphere(const std::span<float> xs, const std::span<float> ys, const std::span<float> zs, const float radius) noexcept
+    {
+        const __m128 scale{ _mm_set1_ps(radius) };
+        internal::fillSoA(xs, ys, zs, [this, scale](__m128& x, __m128& y, __m128& z) {
+            const __m128 u0{ internal::toUnitFloat(nextUInt4()) };
+            const __m128 u1{ internal::toUnitFloat(nextUInt4()) };
+            const __m128 u2{ internal::toUnitFloat(nextUInt4()) };
+            internal::unitVectors(u0, u1, x, y, z);
+            const __m128 distance{ _mm_mul_ps(scale, internal::cubeRoot(u2)) };
+            x = _mm_mul_ps(x, distance);
+            y = _mm_mul_ps(y, distance);
+            z = _mm_mul_ps(z, distance);
+        });
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <Core/Module/ModuleRegistry.hpp>
+
+namespace zen
+{
+    /**
+    * @brief Mathモジュールの宣言を作成します。Coreモジュールに依存します。
+    */
+    [[nodiscard]]
+    ModuleDescriptor makeMathModule();
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace zen
+{
+    /**
+    * @brief シードから生成した順列表を用いる、改良パーリンノイズ。
+    *
+    * 配列をまとめて評価する関数は、AVX2が利用できる環境では8要素ずつ並列に評価します。
+    * 結果は一要素ずつ評価した場合と同じ値になります。
+    * この一致は浮動小数点演算の融合を禁止してビルドしていることを前提とします(Math/CMakeLists.txtを参照)。
+    */
+    class PerlinNoise final
+    {
+    public:
+        /**
+        * @param[in] seed 順列表を生成するためのシード値
+        */
+        explicit PerlinNoise(uint64_t seed) noexcept;
+
+        /**
+        * @brief 2次元のノイズを評価します。
+        *
+        * @return おおよそ[-1, 1]の値
+        */
+        [[nodiscard]] float evaluate(float x, float y) const noexcept;
+
+        /**
+        * @brief 3次元のノイズを評価します。
+        *
+        * @return おおよそ[-1, 1]の値
+        */
+        [[nodiscard]] float evaluate(float x, float y, float z) const noexcept;
+
+        /**
+        * @brief SoA形式の座標に対して2次元のノイズをまとめて評価します。
+        *
+        * @pre xs, ys, resultsの要素数が等しくなければいけません。
+        */
+        void evaluate(std::span<const float> xs, std::span<const float> ys, std::span<float> results) const noexcept;
+
+        /**
+        * @brief SoA形式の座標に対して3次元のノイズをまとめて評価します。
+        *
+        * @pre xs, ys, zs, resultsの要素数が等しくなければいけません。
+        */
+        void evaluate(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> results) const noexcept;
+
+    private:
+        std::array<int32_t, 512> _permutation;  ///< 0から255の順列を二回繰り返した表
+    };
+}
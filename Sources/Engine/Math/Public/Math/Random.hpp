@@ -0,0 +1,106 @@
+#pragma once
+#include <Math/Vector3.hpp>
+#include <Math/Vector4.hpp>
+#include <Core/Platform/PlatformDefine.hpp>
+#include <cstdint>
+#include <emmintrin.h>
+#include <span>
+
+namespace zen
+{
+    /**
+    * @brief SIMDの4レーンで独立した系列を並列に生成するxoshiro128+乱数生成器。
+    *
+    * 同じseedとstreamからは常に同じ系列が得られます。スレッドごとに異なるstreamを指定して利用してください。
+    * スレッドセーフではありません。
+    */
+    class alignas(16) Random final
+    {
+    public:
+        /**
+        * @brief 乱数の系列を初期化します。
+        *
+        * @param[in] seed シード値
+        * @param[in] stream 同じシードから独立した系列を得るための番号
+        */
+        explicit Random(uint64_t seed, uint64_t stream = 0) noexcept;
+
+        /**
+        * @brief [0, 1)の一様乱数を4つ生成します。
+        */
+        [[nodiscard]] Vector4f nextFloat4() noexcept;
+
+        /**
+        * @brief 単位球面上に一様に分布する点を生成します。
+        *
+        * fillUnitVectors()と同じ近似で計算しますが、4レーンのうち1つしか使わないため並列化されません。
+        * 多数の点を生成する場合はfillUnitVectors()を使ってください。
+        */
+        [[nodiscard]] Vector3f nextUnitVector() noexcept;
+
+        /**
+        * @brief 球の内部に一様に分布する点を生成します。
+        *
+        * fillPointsInSphere()と同じ近似で計算しますが、4レーンのうち1つしか使わないため並列化されません。
+        * 多数の点を生成する場合はfillPointsInSphere()を使ってください。
+        *
+        * @param[in] radius 球の半径
+        */
+        [[nodiscard]] Vector3f nextPointInSphere(float radius) noexcept;
+
+        /**
+        * @brief 32bitの一様乱数で配列を埋めます。
+        */
+        void fillUInts(std::span<uint32_t> values) noexcept;
+
+        /**
+        * @brief [min, max)の一様乱数で配列を埋めます。
+        */
+        void fillFloats(std::span<float> values, float min, float max) noexcept;
+
+        /**
+        * @brief 単位球面上の点をSoA形式の配列に生成します。
+        *
+        * @pre xs, ys, zsの要素数が等しくなければいけません。
+        */
+        void fillUnitVectors(std::span<float> xs, std::span<float> ys, std::span<float> zs) noexcept;
+
+        /**
+        * @brief 球の内部の点をSoA形式の配列に生成します。
+        *
+        * @pre xs, ys, zsの要素数が等しくなければいけません。
+        */
+        void fillPointsInSphere(std::span<float> xs, std::span<float> ys, std::span<float> zs, float radius) noexcept;
+
+    private:
+        [[nodiscard]] __m128i nextUInt4() noexcept;
+
+        // 各レーンのxoshiro128+の状態
+        __m128i _s0;
+        __m128i _s1;
+        __m128i _s2;
+        __m128i _s3;
+    };
+
+    ZEN_FORCEINLINE __m128i Random::nextUInt4() noexcept
+    {
+        const __m128i result{ _mm_add_epi32(_s0, _s3) };
+        const __m128i t{ _mm_slli_epi32(_s1, 9) };
+
+        _s2 = _mm_xor_si128(_s2, _s0);
+        _s3 = _mm_xor_si128(_s3, _s1);
+        _s1 = _mm_xor_si128(_s1, _s2);
+        _s0 = _mm_xor_si128(_s0, _s3);
+        _s2 = _mm_xor_si128(_s2, t);
+        _s3 = _mm_or_si128(_mm_slli_epi32(_s3, 11), _mm_srli_epi32(_s3, 21));
+
+        return result;
+    }
+
+    ZEN_FORCEINLINE Vector4f Random::nextFloat4() noexcept
+    {
+        // xoshiro128+は下位ビットの品質が低いため、上位23bitを仮数部に使って[1, 2)の値を作る。
+        const __m128i bits{ _mm_or_si128(_mm_srli_epi32(nextUInt4(), 9), _mm_set1_epi32(0x3f800000)) };
+        return Vector4f{ _mm_sub_ps(_mm_castsi128_ps(bits), _mm_set1_ps(1.0f)) };
+    }
+}
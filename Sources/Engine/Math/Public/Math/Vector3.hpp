@@ -154,6 +154,17 @@ namespace zen
         */
         [[nodiscard]] static float angleBetween(const Vector3f& v1, const Vector3f& v2) noexcept;
 
+        /**
+        * @brief 二つのベクトルを線形補間します。
+        *
+        * @param[in] v1 t = 0のときのベクトル
+        * @param[in] v2 t = 1のときのベクトル
+        * @param[in] t 補間係数
+        *
+        * @return 補間されたベクトル
+        */
+        [[nodiscard]] static Vector3f lerp(const Vector3f& v1, const Vector3f& v2, float t) noexcept;
+
         static const Vector3f zero;
         static const Vector3f one;
 
@@ -372,4 +383,9 @@ namespace zen
     {
         return std::acos(Vector3f::dot(v1, v2) / std::sqrt(v1.lengthSquared() * v2.lengthSquared()));
     }
+
+    ZEN_FORCEINLINE Vector3f Vector3f::lerp(const Vector3f& v1, const Vector3f& v2, const float t) noexcept
+    {
+        return v1 + (v2 - v1) * t;
+    }
 }
\ No newline at end of file
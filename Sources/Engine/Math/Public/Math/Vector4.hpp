@@ -1,5 +1,7 @@
 #pragma once
+#include <Core/Misc/Assert.hpp>
 #include <Core/Platform/PlatformDefine.hpp>
+#include <cstdint>
 #include <xmmintrin.h>
 #include <smmintrin.h>
 
@@ -30,6 +32,13 @@ namespace zen
         */
         Vector4f(float x, float y, float z, float w) noexcept;
 
+        /**
+        * @brief SIMDレジスタの値で初期化するコンストラクタ。
+        *
+        * @param[in] value x, y, z, wの順に格納された値
+        */
+        explicit Vector4f(SimdType value) noexcept;
+
 
         Vector4f(const Vector4f& other) noexcept = default;
         Vector4f& operator=(const Vector4f& other) noexcept = default;
@@ -108,6 +117,11 @@ namespace zen
     {
     }
 
+    ZEN_FORCEINLINE Vector4f::Vector4f(const SimdType value) noexcept
+        : _value{ value }
+    {
+    }
+
     ZEN_FORCEINLINE Vector4f Vector4f::operator-() const noexcept
     {
         return Vector4f{ _mm_sub_ps(_mm_setzero_ps(), _value) };